@@ -0,0 +1,182 @@
+
+#include "accuracy.hpp"
+
+#include "util/dimension.hpp"
+#include "util/real.hpp"
+#include "util/vec2.hpp"
+#include "util/vec2x.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <numbers>
+#include <ostream>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace Bench
+{
+
+
+namespace
+{
+
+
+// The relative error that fastRsqrt and unitFast document
+constexpr double tolerance = 1e-5;
+// The ratios between consecutive magnitudes of the sweeps, so that every exponent is sampled at many mantissas
+// The vectors are swept in each of the directions, so they take larger steps
+constexpr float scalarSweepStep = 1.0001f;
+constexpr float vectorSweepStep = 1.001f;
+constexpr size_t directionCount = 16;
+// The vectors given to Util::unitFast at a time, which isn't a multiple of the lane count so that its scalar tail is checked
+constexpr size_t batchSize = 1021;
+static_assert(batchSize % Util::defaultLaneCount<float> != 0);
+
+using Limits = std::numeric_limits<float>;
+using FloatDisplacement = Util::Vec2<Util::Distance<float, Util::BaseRatio> >;
+using FloatUnit = decltype(std::declval<FloatDisplacement>().unitFast() );
+
+// The unitFast that is checked: Vec2::unitFast, or Util::unitFast over spans, which uses Vec2x::unitFast
+enum class UnitFastPath {
+    scalar,
+    span,
+};
+
+
+struct Check {
+    const char* name;
+    double maxError;
+    bool isPassing;
+};
+
+// Calls f with magnitudes from first to last, geometrically spaced, including both
+// Among the denormals the step rounds to nothing, so each magnitude is at least the next float
+template<typename F>
+void sweepMagnitudes(float first, float last, float step, const F& f) {
+    for(float magnitude = first; magnitude < last;
+        magnitude = std::max(magnitude * step, std::nextafter(magnitude, Limits::infinity() ) ) )
+        f(magnitude);
+    f(last);
+}
+
+// Calls f with vectors of each magnitude in every direction, which aren't on the axes
+template<typename F>
+void sweepVectors(float first, float last, const F& f) {
+    std::array<std::pair<double, double>, directionCount> directionLst;
+    for(size_t i=0; i<directionCount; ++i) {
+        const double angle = 2 * std::numbers::pi * static_cast<double>(i) / directionCount + 0.1;
+        directionLst[i] = {std::cos(angle), std::sin(angle)};
+    }
+    sweepMagnitudes(first, last, vectorSweepStep, [&](float magnitude) {
+        for(const auto& [dirX, dirY] : directionLst) {
+            f(FloatDisplacement{
+                Util::Distance<float, Util::BaseRatio>{static_cast<float>(magnitude * dirX)},
+                Util::Distance<float, Util::BaseRatio>{static_cast<float>(magnitude * dirY)},
+            });
+        }
+    });
+}
+
+Check checkFastRsqrt() {
+    double maxError = 0;
+    sweepMagnitudes(Limits::min(), Limits::max(), scalarSweepStep, [&](float x) {
+        const double exact = 1 / std::sqrt(static_cast<double>(x) );
+        maxError = std::max(maxError, std::abs(Util::fastRsqrt(x) - exact) / exact);
+    });
+    return {"fastRsqrt, normal floats", maxError, maxError <= tolerance};
+}
+
+// Calls f with each of the vectors and its unitFast, computed by the path
+template<typename F>
+void sweepUnitFast(float first, float last, UnitFastPath path, const F& f) {
+    std::vector<FloatDisplacement> vecLst;
+    std::vector<FloatUnit> unitLst(batchSize);
+    vecLst.reserve(batchSize);
+    const auto checkBatch = [&]{
+        if(path == UnitFastPath::span)
+            Util::unitFast(std::span<const FloatDisplacement>{vecLst}, std::span{unitLst});
+        for(size_t i=0; i<vecLst.size(); ++i)
+            f(vecLst[i], path == UnitFastPath::span ? unitLst[i] : vecLst[i].unitFast() );
+        vecLst.clear();
+    };
+    sweepVectors(first, last, [&](const FloatDisplacement& vec) {
+        vecLst.push_back(vec);
+        if(vecLst.size() == batchSize)
+            checkBatch();
+    });
+    checkBatch();
+}
+
+// The error of each component, relative to the unit length
+double unitError(const FloatDisplacement& vec, const FloatUnit& fast) {
+    const auto exact = vec.unit();
+    return std::max(std::abs(static_cast<double>(fast.x.value) - exact.x.value),
+                    std::abs(static_cast<double>(fast.y.value) - exact.y.value) );
+}
+
+Check checkUnitFast(UnitFastPath path) {
+    // Below the first the square magnitude is denormal, above the last it overflows
+    const float first = std::sqrt(Limits::min() ) * 2;
+    const float last = std::sqrt(Limits::max() ) / 2;
+    double maxError = 0;
+    sweepUnitFast(first, last, path, [&](const FloatDisplacement& vec, const FloatUnit& unit) {
+        maxError = std::max(maxError, unitError(vec, unit) );
+    });
+    const char* name = path == UnitFastPath::span ? "unitFast span, normal square magnitudes"
+                                                  : "unitFast, normal square magnitudes";
+    return {name, maxError, maxError <= tolerance};
+}
+
+// Documented to give zero for zero, and to come out shorter than unit length when the square magnitude underflows
+Check checkUnitFastTiny(UnitFastPath path) {
+    // From zero, so that the first vectors are zero vectors
+    const float last = std::sqrt(Limits::min() ) * 2;
+    double maxLength = 0;
+    bool isPassing = true;
+    sweepUnitFast(0, last, path, [&](const FloatDisplacement& vec, const FloatUnit& unit) {
+        const double length = std::hypot(static_cast<double>(unit.x.value), static_cast<double>(unit.y.value) );
+        isPassing = isPassing && std::isfinite(length) && (!vec.isZero() || unit.isZero() );
+        maxLength = std::max(maxLength, length);
+    });
+    // The length that is over 1, as the error
+    const double maxError = std::max(maxLength - 1, 0.0);
+    const char* name = path == UnitFastPath::span ? "unitFast span, zero and denormal vectors"
+                                                  : "unitFast, zero and denormal vectors";
+    return {name, maxError, isPassing && maxError <= tolerance};
+}
+
+
+} // namespace
+
+
+bool checkAccuracy(std::ostream& os) {
+    const Check checkLst[] = {
+        checkFastRsqrt(),
+        checkUnitFast(UnitFastPath::scalar),
+        checkUnitFastTiny(UnitFastPath::scalar),
+        checkUnitFast(UnitFastPath::span),
+        checkUnitFastTiny(UnitFastPath::span),
+    };
+
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os<<std::left<<std::setw(44)<<"accuracy check"<<std::right<<std::setw(14)<<"max error"<<std::setw(14)<<"tolerance"
+      <<"  status\n";
+    bool isPassing = true;
+    for(const auto& check : checkLst) {
+        os<<std::left<<std::setw(44)<<check.name<<std::right<<std::scientific<<std::setprecision(3)
+          <<std::setw(14)<<check.maxError<<std::setw(14)<<tolerance<<(check.isPassing ? "  ok" : "  FAILED")<<'\n';
+        isPassing = isPassing && check.isPassing;
+    }
+    os.flags(flags);
+    os.precision(precision);
+    return isPassing;
+}
+
+
+} // namespace Bench
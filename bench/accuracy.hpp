@@ -0,0 +1,25 @@
+
+#ifndef HPP_BENCH_ACCURACY_
+#define HPP_BENCH_ACCURACY_
+
+#include <iosfwd>
+
+
+namespace Bench
+{
+
+
+/**
+ * @brief Sweep the approximations of the hot paths over the magnitudes of float, and compare them with the exact
+ *        functions: fastRsqrt with 1/std::sqrt, and Vec2::unitFast and Util::unitFast over spans with Vec2::unit
+ * @return true if every maximum error is within the documented tolerance, after printing a table of them
+ * @note Covers the smallest and largest normal floats, denormal and zero vectors, and vectors
+ *       up to the largest magnitude whose square doesn't overflow. The spans aren't a multiple of the lane count,
+ *       so both the SIMD lanes and the scalar tail of Util::unitFast are checked
+ */
+[[nodiscard]] bool checkAccuracy(std::ostream& os);
+
+
+} // namespace Bench
+
+#endif // ifndef HPP_BENCH_ACCURACY_
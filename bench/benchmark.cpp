@@ -0,0 +1,58 @@
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+
+namespace Bench
+{
+
+
+Result makeResult(std::string_view name, size_t itemCount, std::vector<double> nsPerItemLst) {
+    std::vector<double> sortedLst = nsPerItemLst;
+    std::sort(sortedLst.begin(), sortedLst.end() );
+    const size_t middle = sortedLst.size() / 2;
+    const double median = sortedLst.size() % 2 == 1 ? sortedLst[middle] : (sortedLst[middle - 1] + sortedLst[middle]) / 2;
+    return {
+        std::string(name),
+        itemCount,
+        median,
+        sortedLst.front(),
+        std::move(nsPerItemLst),
+    };
+}
+
+
+Runner::Runner(std::ostream& os_, std::string_view filter_) :
+    rOs{os_},
+    mFilter{filter_}
+{
+    rOs<<std::left<<std::setw(44)<<"benchmark"<<std::right
+       <<std::setw(10)<<"items"<<std::setw(14)<<"median ns"<<std::setw(14)<<"min ns"<<'\n';
+}
+
+const std::vector<Result>& Runner::results() const {
+    return mResultLst;
+}
+
+bool Runner::isSelected(std::string_view name) const {
+    return name.find(mFilter) != std::string_view::npos;
+}
+
+void Runner::addResult(std::string_view name, size_t itemCount, std::vector<double> nsPerItemLst) {
+    const Result& result = mResultLst.emplace_back(makeResult(name, itemCount, std::move(nsPerItemLst) ) );
+
+    const auto flags = rOs.flags();
+    const auto precision = rOs.precision();
+    rOs<<std::left<<std::setw(44)<<result.name<<std::right
+       <<std::setw(10)<<result.itemCount
+       <<std::fixed<<std::setprecision(3)
+       <<std::setw(14)<<result.medianNsPerItem<<std::setw(14)<<result.minNsPerItem<<std::endl;
+    rOs.flags(flags);
+    rOs.precision(precision);
+}
+
+
+} // namespace Bench
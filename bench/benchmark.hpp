@@ -0,0 +1,101 @@
+
+#ifndef HPP_BENCH_BENCHMARK_
+#define HPP_BENCH_BENCHMARK_
+
+#include "util/macros.hpp"
+#include "util/typedefs.hpp"
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace Bench
+{
+
+
+/**
+ * @brief Make the compiler assume that the value is used, so the work producing it isn't optimised away
+ */
+template<typename T>
+UTIL_ALWAYS_INLINE void doNotOptimize(const T& value) {
+#ifdef __GNUC__
+    asm volatile ("" : : "r" (&value) : "memory");
+#else
+    const volatile auto* volatile sink = &value;
+    (void)sink;
+#endif // ifdef __GNUC__
+}
+
+
+struct Result {
+    std::string name;
+    size_t itemCount;       // The number of items processed by a single call
+    double medianNsPerItem;
+    double minNsPerItem;
+    std::vector<double> nsPerItemLst; // Every sample
+};
+
+/**
+ * @brief Make a result from its samples, which must not be empty
+ */
+[[nodiscard]] Result makeResult(std::string_view name, size_t itemCount, std::vector<double> nsPerItemLst);
+
+
+/**
+ * @brief Runs the benchmarks whose name contain the filter, and prints their results
+ * @note The number of calls per sample is calibrated so that a sample takes at least minSampleDuration,
+ *       then the median and minimum of sampleCount samples are reported
+ */
+class Runner {
+public:
+    constexpr static size_t sampleCount = 15;
+    constexpr static std::chrono::nanoseconds minSampleDuration = std::chrono::milliseconds{2};
+
+    Runner(std::ostream& os_, std::string_view filter_);
+
+    /**
+     * @param name - should be "what/variant/size", so that variants of the same thing are listed together
+     * @param itemCount - the number of items that a single call of body processes
+     */
+    template<typename F>
+    void run(std::string_view name, size_t itemCount, F&& body) {
+        if(!isSelected(name) )
+            return;
+        using std::chrono::steady_clock;
+        const auto timeCalls = [&body](size_t callCount) {
+            const auto startTime = steady_clock::now();
+            for(size_t i=0; i<callCount; ++i)
+                body();
+            return steady_clock::now() - startTime;
+        };
+
+        size_t callCount = 1;
+        while(timeCalls(callCount) < minSampleDuration)
+            callCount *= 2;
+        std::vector<double> nsPerItemLst(sampleCount);
+        for(auto& nsPerItem : nsPerItemLst) {
+            const auto sampleDuration = std::chrono::duration<double, std::nano>{timeCalls(callCount)};
+            nsPerItem = sampleDuration.count() / static_cast<double>(callCount * itemCount);
+        }
+        addResult(name, itemCount, std::move(nsPerItemLst) );
+    }
+
+    [[nodiscard]] const std::vector<Result>& results() const;
+
+private:
+    [[nodiscard]] bool isSelected(std::string_view name) const;
+    void addResult(std::string_view name, size_t itemCount, std::vector<double> nsPerItemLst);
+
+    std::ostream& rOs;
+    std::string mFilter;
+    std::vector<Result> mResultLst{};
+};
+
+
+} // namespace Bench
+
+#endif // ifndef HPP_BENCH_BENCHMARK_
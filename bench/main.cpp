@@ -0,0 +1,462 @@
+
+#include "accuracy.hpp"
+#include "benchmark.hpp"
+#include "regression.hpp"
+
+#include "game/circle.hpp"
+#include "game/components.hpp"
+#include "game/entities.hpp"
+#include "game/systems.hpp"
+
+#include "media/camera.hpp"
+#include "media/core.hpp"
+#include "media/quad_vertices.hpp"
+#include "media/sprite.hpp"
+
+#include "util/project_info.hpp"
+#include "util/rect.hpp"
+#include "util/rect_arrays.hpp"
+#include "util/registry.hpp"
+#include "util/rng.hpp"
+#include "util/vec2.hpp"
+#include "util/vec2x.hpp"
+#include "util/worker_pool.hpp"
+
+#include <SDL2/SDL_render.h>
+#include <SDL2/SDL_surface.h>
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+
+
+using namespace Util::Udl;
+using namespace Media::Udl;
+using Bench::doNotOptimize;
+
+
+// Every benchmark generates its data from the same seed, so that runs are comparable
+constexpr uint64_t seed = 0x5EED;
+// The number of items processed by a call of the benchmarks that aren't run at several sizes
+constexpr size_t itemCount = 1024;
+
+constexpr auto worldSize = static_cast<Util::BaseDisplacement>(Media::windowsSize);
+constexpr auto worldRect = Util::BaseRect::leftTopSize({0_bl, 0_bl}, worldSize);
+
+constexpr Media::Animation circleAnimation = {
+    .modeName="default",
+    .frameLst={{
+        .rect = Media::PixelRect::leftTopSize({64_pl, 0_pl}, {64_pl, 64_pl}),
+        .time = Media::forever,
+    }},
+};
+
+
+Util::Real getReal(Util::Rng& rng, Util::Real minimum, Util::Real maximum) {
+    return rng.getFloat(static_cast<float>(minimum), static_cast<float>(maximum) );
+}
+
+Util::BasePosition getPosition(Util::Rng& rng) {
+    return {
+        Util::BasePositionScalar{getReal(rng, worldRect.left().value, worldRect.right().value)},
+        Util::BasePositionScalar{getReal(rng, worldRect.top().value, worldRect.bottom().value)},
+    };
+}
+
+Util::BaseRect getRect(Util::Rng& rng) {
+    const Util::BaseDistance width{getReal(rng, 0.25f, 5.0f)};
+    const Util::BaseDistance height{getReal(rng, 0.25f, 5.0f)};
+    return Util::BaseRect::centreSize(getPosition(rng), {width, height});
+}
+
+Game::Circle getCircle(Util::Rng& rng) {
+    return {.radius=Util::BaseDistance{getReal(rng, 0.25f, 2.5f)}, .centre=getPosition(rng)};
+}
+
+
+// Only reads components that EnemySystem doesn't write, so that they can run in parallel
+struct EnemyMassSystem {
+    using Reads = Util::TypeList<Game::EnemyTag, Game::Mass>;
+    using Writes = Util::TypeList<>;
+
+    Util::BaseMass& totalMass;
+
+    void operator()(Game::World& world) const {
+        Util::BaseMass total = Util::BaseMass::zero();
+        world.each<const Game::EnemyTag, const Game::Mass>([&total](Util::Entity, const Game::EnemyTag&, const Game::Mass& mass) {
+            total += mass.value;
+        });
+        totalMass = total;
+    }
+};
+
+static_assert(!Util::systemsConflict<Game::EnemySystem, EnemyMassSystem>);
+
+
+// A renderer that draws to a surface in memory, so textures can be made without a window
+class SoftwareRenderer {
+public:
+    SoftwareRenderer() :
+        mSurface{SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_RGBA32), &SDL_FreeSurface}
+    {
+        if(!mSurface)
+            throw std::runtime_error(std::string("Can't create the surface\n") + SDL_GetError() );
+        mRenderer.reset(SDL_CreateSoftwareRenderer(mSurface.get() ) );
+        if(!mRenderer)
+            throw std::runtime_error(std::string("Can't create the software renderer\n") + SDL_GetError() );
+        // The same size as images/circles.png
+        mTexture.reset(SDL_CreateTexture(mRenderer.get(), SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 128, 64) );
+        if(!mTexture)
+            throw std::runtime_error(std::string("Can't create the texture\n") + SDL_GetError() );
+    }
+
+    [[nodiscard]] SDL_Texture* texture() const {
+        return mTexture.get();
+    }
+
+private:
+    std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> mSurface;
+    std::unique_ptr<SDL_Renderer, decltype(&SDL_DestroyRenderer)> mRenderer{nullptr, &SDL_DestroyRenderer};
+    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> mTexture{nullptr, &SDL_DestroyTexture};
+};
+
+
+void benchCollision(Bench::Runner& runner) {
+    Util::Rng rng{seed};
+    std::vector<Util::BaseRect> rectLst;
+    std::vector<Util::BaseRect> otherRectLst;
+    std::vector<Game::Circle> circleLst;
+    std::vector<Game::Circle> otherCircleLst;
+    for(size_t i=0; i<itemCount; ++i) {
+        rectLst.push_back(getRect(rng) );
+        otherRectLst.push_back(getRect(rng) );
+        circleLst.push_back(getCircle(rng) );
+        otherCircleLst.push_back(getCircle(rng) );
+    }
+
+    runner.run("hasCollision/rect", itemCount, [&]{
+        size_t collisionCount = 0;
+        for(size_t i=0; i<itemCount; ++i)
+            collisionCount += Util::hasCollision(rectLst[i], otherRectLst[i]);
+        doNotOptimize(collisionCount);
+    });
+    runner.run("hasCollision/circle", itemCount, [&]{
+        size_t collisionCount = 0;
+        for(size_t i=0; i<itemCount; ++i)
+            collisionCount += Game::hasCollision(circleLst[i], otherCircleLst[i]);
+        doNotOptimize(collisionCount);
+    });
+
+    // One rect against many, like culling, and pairs of rects, like a broadphase
+    Util::BaseRectArrays rectArrays;
+    Util::BaseRectArrays otherRectArrays;
+    Util::BaseRectArrays outRectArrays;
+    for(size_t i=0; i<itemCount; ++i) {
+        rectArrays.push_back(rectLst[i]);
+        otherRectArrays.push_back(otherRectLst[i]);
+    }
+    const Util::BaseRect queryRect = Util::BaseRect::centreSize(worldRect.centre(), worldRect.size() * 0.25_r);
+    std::vector<uint8_t> hitLst(itemCount);
+    std::vector<Util::BaseRect> outRectLst(itemCount, Util::BaseRect::zero() );
+    runner.run("rectBatch/collisionMask/scalar", itemCount, [&]{
+        size_t collisionCount = 0;
+        for(size_t i=0; i<itemCount; ++i) {
+            hitLst[i] = Util::hasCollision(queryRect, rectLst[i]);
+            collisionCount += hitLst[i];
+        }
+        doNotOptimize(collisionCount);
+        doNotOptimize(hitLst.data() );
+    });
+    runner.run("rectBatch/collisionMask/arrays", itemCount, [&]{
+        doNotOptimize(Util::collisionMask(queryRect, rectArrays.spans(), std::span{hitLst}) );
+        doNotOptimize(hitLst.data() );
+    });
+    runner.run("rectBatch/intersection/scalar", itemCount, [&]{
+        for(size_t i=0; i<itemCount; ++i)
+            outRectLst[i] = Util::intersection(rectLst[i], otherRectLst[i]);
+        doNotOptimize(outRectLst.data() );
+    });
+    runner.run("rectBatch/intersection/arrays", itemCount, [&]{
+        Util::intersection(rectArrays.spans(), otherRectArrays.spans(), outRectArrays);
+        doNotOptimize(outRectArrays.leftLst().data() );
+    });
+    runner.run("rectBatch/boundingRect/scalar", itemCount, [&]{
+        Util::BaseRect bound = rectLst[0];
+        for(size_t i=1; i<itemCount; ++i)
+            bound = Util::boundingRect(bound, rectLst[i]);
+        doNotOptimize(bound);
+    });
+    runner.run("rectBatch/boundingRect/arrays", itemCount, [&]{
+        doNotOptimize(Util::boundingRect(rectArrays.spans() ) );
+    });
+}
+
+void benchVec2(Bench::Runner& runner) {
+    Util::Rng rng{seed};
+    std::vector<Util::BaseDisplacement> displacementLst;
+    for(size_t i=0; i<itemCount; ++i)
+        displacementLst.push_back(getPosition(rng) - getPosition(rng) );
+    using UnitVector = decltype(std::declval<Util::BaseDisplacement>().unit() );
+    std::vector<UnitVector> unitLst(itemCount);
+    std::vector<Util::BaseDistance> magnitudeLst(itemCount);
+
+    runner.run("Vec2/unit", itemCount, [&]{
+        for(size_t i=0; i<itemCount; ++i)
+            unitLst[i] = displacementLst[i].unit();
+        doNotOptimize(unitLst.data() );
+    });
+    runner.run("Vec2/unitFast", itemCount, [&]{
+        for(size_t i=0; i<itemCount; ++i)
+            unitLst[i] = displacementLst[i].unitFast();
+        doNotOptimize(unitLst.data() );
+    });
+    runner.run("Vec2x/unitFast", itemCount, [&]{
+        Util::unitFast(std::span<const Util::BaseDisplacement>{displacementLst}, std::span{unitLst});
+        doNotOptimize(unitLst.data() );
+    });
+    runner.run("Vec2/magnitude", itemCount, [&]{
+        for(size_t i=0; i<itemCount; ++i)
+            magnitudeLst[i] = displacementLst[i].magnitude();
+        doNotOptimize(magnitudeLst.data() );
+    });
+    runner.run("Vec2x/magnitude", itemCount, [&]{
+        constexpr size_t laneCount = Util::BaseDisplacementX::laneCount;
+        static_assert(itemCount % laneCount == 0);
+        for(size_t i=0; i<itemCount; i+=laneCount)
+            Util::BaseDisplacementX::load(displacementLst.data() + i).magnitude().store(magnitudeLst.data() + i);
+        doNotOptimize(magnitudeLst.data() );
+    });
+}
+
+void benchRng(Bench::Runner& runner) {
+    Util::Rng rng{seed};
+    std::vector<float> valueLst(itemCount);
+
+    runner.run("Rng/getFloat", itemCount, [&]{
+        for(size_t i=0; i<itemCount; ++i)
+            valueLst[i] = rng.getFloat(-1.0f, 1.0f);
+        doNotOptimize(valueLst.data() );
+    });
+    runner.run("Rng/fillFloats", itemCount, [&]{
+        rng.fillFloats(valueLst, -1.0f, 1.0f);
+        doNotOptimize(valueLst.data() );
+    });
+}
+
+void benchCamera(Bench::Runner& runner) {
+    Util::Rng rng{seed};
+    const Media::Camera camera{Media::windowsSize};
+    std::vector<Util::BasePosition> worldCoordLst;
+    for(size_t i=0; i<itemCount; ++i)
+        worldCoordLst.push_back(getPosition(rng) );
+    std::vector<Media::PixelPosition> screenCoordLst(itemCount);
+
+    runner.run("toScreenCoord/scalar", itemCount, [&]{
+        for(size_t i=0; i<itemCount; ++i)
+            screenCoordLst[i] = camera.toScreenCoord(worldCoordLst[i]);
+        doNotOptimize(screenCoordLst.data() );
+    });
+    runner.run("toScreenCoord/batch", itemCount, [&]{
+        camera.toScreenCoords(worldCoordLst, screenCoordLst);
+        doNotOptimize(screenCoordLst.data() );
+    });
+}
+
+void benchVertices(Bench::Runner& runner, SDL_Texture* texture) {
+    const Media::Camera camera{Media::windowsSize};
+    const Media::Sprite sprite{texture, {&circleAnimation, 1}};
+    constexpr SDL_Colour colour{0xFF, 0xFF, 0xFF, SDL_ALPHA_OPAQUE};
+
+    // The streaming stores of writeQuadVertices are only used for the larger size
+    for(const size_t quadCount : {size_t{1024}, size_t{16384}}) {
+        Util::Rng rng{seed};
+        std::vector<Util::BaseRect> rectLst;
+        Util::BaseRectArrays rectArrays;
+        for(size_t i=0; i<quadCount; ++i)
+            rectArrays.push_back(rectLst.emplace_back(getRect(rng) ) );
+        const std::vector<float> textureLeftLst(quadCount, 0.5f);
+        const std::vector<float> textureTopLst(quadCount, 0.0f);
+        const std::vector<float> textureRightLst(quadCount, 1.0f);
+        const std::vector<float> textureBottomLst(quadCount, 1.0f);
+        const Media::QuadArrays quads{
+            rectArrays,
+            textureLeftLst, textureTopLst, textureRightLst, textureBottomLst,
+        };
+        std::vector<SDL_Vertex> vertexLst(quadCount * 4);
+
+        const std::string sizeName = "/" + std::to_string(quadCount);
+        runner.run("quadVertices/getVertices" + sizeName, quadCount, [&]{
+            for(size_t i=0; i<quadCount; ++i) {
+                const auto quadVertexLst = sprite.getVertices(rectLst[i], camera);
+                std::copy(quadVertexLst.begin(), quadVertexLst.end(), vertexLst.begin() + static_cast<ptrdiff_t>(i * 4) );
+            }
+            doNotOptimize(vertexLst.data() );
+        });
+        runner.run("quadVertices/writeQuadVertices" + sizeName, quadCount, [&]{
+            Media::writeQuadVertices(quads, camera, colour, vertexLst);
+            doNotOptimize(vertexLst.data() );
+        });
+    }
+}
+
+void benchEnemies(Bench::Runner& runner, SDL_Texture* texture) {
+    constexpr Util::Second dt = 1_r / 64_hz;
+
+    for(const size_t enemyCount : {size_t{16}, size_t{256}, size_t{4096}, size_t{32768}}) {
+        Util::Rng rng{seed};
+        Game::World world;
+        world.reserve(enemyCount + 1);
+        // Far from the enemies, so that every enemy is checked against the player
+        const Util::Entity player = Game::spawnPlayer(world, texture);
+        world.get<Game::Circle>(player) = {.radius=1_bl, .centre={-100_bl, -100_bl}};
+        for(size_t i=0; i<enemyCount; ++i)
+            Game::spawnEnemy(world, texture, getCircle(rng) );
+
+        runner.run("updateEnemies/" + std::to_string(enemyCount), enemyCount, [&]{
+            doNotOptimize(Game::updateWorld(world, player, worldRect, dt) );
+        });
+        // With a system that only reads the enemies on another thread
+        runner.run("updateEnemies/parallel/" + std::to_string(enemyCount), enemyCount, [&]{
+            bool hasHitPlayer = false;
+            Util::BaseMass totalMass = Util::BaseMass::zero();
+            Util::runParallel(Util::defaultWorkerPool(), world,
+                              Game::EnemySystem{worldRect, dt, world.get<Game::Circle>(player), hasHitPlayer},
+                              EnemyMassSystem{totalMass});
+            doNotOptimize(hasHitPlayer);
+            doNotOptimize(totalMass);
+        });
+    }
+}
+
+
+
+constexpr const char* usage =
+    "Usage: dodge_it_bench [FILTER] [--baseline PATH] [--require-baseline] [--save-baseline PATH] [--threshold PERCENT]\n"
+    "  FILTER                only run the benchmarks with a name containing it\n"
+    "  --baseline PATH       compare with the baseline, and fail if a benchmark regressed\n"
+    "  --require-baseline    also fail if the baseline is empty, or a benchmark isn't in it or has a different item count\n"
+    "  --save-baseline PATH  add the results to the baseline, replacing the ones with the same name\n"
+    "  --threshold PERCENT   the smallest slowdown of the median that is a regression (default 5)";
+
+struct Options {
+    std::string filter{};
+    std::optional<std::filesystem::path> baselinePath{};
+    std::optional<std::filesystem::path> saveBaselinePath{};
+    bool isBaselineRequired = false;
+    Bench::RegressionOptions regressionOptions{};
+};
+
+Options parseOptions(std::span<const char* const> argLst) {
+    Options options{};
+    for(size_t i=0; i<argLst.size(); ++i) {
+        const std::string_view arg = argLst[i];
+        const auto getValue = [&]() -> std::string_view {
+            if(i + 1 >= argLst.size() )
+                throw std::runtime_error("Missing value for " + std::string(arg) );
+            return argLst[++i];
+        };
+
+        if(arg == "--baseline") {
+            options.baselinePath = getValue();
+        } else if(arg == "--require-baseline") {
+            options.isBaselineRequired = true;
+        } else if(arg == "--save-baseline") {
+            options.saveBaselinePath = getValue();
+        } else if(arg == "--threshold") {
+            const std::string value{getValue()};
+            char* end = nullptr;
+            const double percent = std::strtod(value.c_str(), &end);
+            if(value.empty() || end != value.c_str() + value.size() || !(percent >= 0) )
+                throw std::runtime_error("Invalid value for --threshold: " + value);
+            options.regressionOptions.threshold = percent / 100;
+        } else if(arg.starts_with("--") || !options.filter.empty() ) {
+            throw std::runtime_error("Unknown argument: " + std::string(arg) );
+        } else {
+            options.filter = arg;
+        }
+    }
+    return options;
+}
+
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    std::cout<<Util::projectName()<<" benchmarks ; "<<Util::projectVersion()<<std::endl;
+
+    Options options{};
+    try {
+        options = parseOptions({argv + 1, static_cast<size_t>(argc - 1)});
+    } catch(const std::exception& e) {
+        std::cerr<<e.what()<<'\n'<<usage<<std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        // Loaded first, so that a bad baseline is found before spending time on the benchmarks
+        const Bench::Baseline baseline = options.baselinePath ? Bench::loadBaseline(*options.baselinePath) : Bench::Baseline{};
+        if(options.isBaselineRequired && baseline.empty() ) {
+            const std::string path = options.baselinePath ? options.baselinePath->string() : "<path>";
+            std::cerr<<"The baseline "<<path<<" has no results, record it first on this machine with "
+                     <<"dodge_it_bench --save-baseline "<<path<<std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // The approximations are only worth benchmarking while they are within their tolerance
+        if(!Bench::checkAccuracy(std::cout) ) {
+            std::cerr<<"An approximation is less accurate than documented"<<std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout<<'\n';
+
+        const SoftwareRenderer renderer;
+        Bench::Runner runner{std::cout, options.filter};
+        benchCollision(runner);
+        benchVec2(runner);
+        benchRng(runner);
+        benchCamera(runner);
+        benchVertices(runner, renderer.texture() );
+        benchEnemies(runner, renderer.texture() );
+
+        if(options.saveBaselinePath) {
+            Bench::Baseline newBaseline = Bench::loadBaseline(*options.saveBaselinePath);
+            Bench::mergeIntoBaseline(newBaseline, runner.results() );
+            Bench::saveBaseline(*options.saveBaselinePath, newBaseline);
+        }
+
+        if(options.baselinePath) {
+            std::cout<<"\nCompared with "<<options.baselinePath->string()<<'\n';
+            const auto [regressionCount, unmatchedCount] =
+                Bench::compareWithBaseline(std::cout, baseline, runner.results(), options.regressionOptions);
+            // Otherwise an empty or outdated baseline would pass without checking anything
+            if(unmatchedCount > 0) {
+                std::cerr<<"Warning: "<<unmatchedCount<<" benchmarks have no baseline to compare with, "
+                         <<"record it with --save-baseline"<<std::endl;
+            }
+            if(regressionCount > 0) {
+                std::cerr<<regressionCount<<" benchmarks regressed"<<std::endl;
+                return EXIT_FAILURE;
+            }
+            if(unmatchedCount > 0 && options.isBaselineRequired)
+                return EXIT_FAILURE;
+        }
+    } catch(const std::exception& e) {
+        std::cerr<<e.what()<<std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
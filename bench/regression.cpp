@@ -0,0 +1,200 @@
+
+#include "regression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+
+namespace Bench
+{
+
+
+namespace
+{
+
+
+constexpr int baselineVersion = 1;
+
+
+const Result* findResult(const std::vector<Result>& resultLst, std::string_view name) {
+    const auto iter = std::find_if(resultLst.begin(), resultLst.end(), [name](const Result& result){
+        return result.name == name;
+    });
+    return iter == resultLst.end() ? nullptr : &*iter;
+}
+
+
+} // namespace
+
+
+Baseline loadBaseline(const std::filesystem::path& path) {
+    if(!std::filesystem::exists(path) )
+        return {};
+    std::ifstream file{path};
+    if(!file)
+        throw std::runtime_error("Can't open the baseline: " + path.string() );
+
+    Baseline baseline;
+    bool hasVersion = false;
+    std::string line;
+    for(size_t lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        const auto malformed = [&](const std::string& reason) {
+            return std::runtime_error(path.string() + ":" + std::to_string(lineNumber) + ": " + reason);
+        };
+        if(line.empty() || line.front() == '#')
+            continue;
+
+        std::istringstream lineStream{line};
+        if(!hasVersion) {
+            std::string keyword;
+            int version = 0;
+            if(!(lineStream>>keyword>>version) || keyword != "version")
+                throw malformed("Expected the version before the results");
+            if(version != baselineVersion)
+                throw malformed("Unsupported baseline version " + std::to_string(version) );
+            hasVersion = true;
+            continue;
+        }
+
+        std::string name;
+        size_t itemCount = 0;
+        if(!(lineStream>>name>>itemCount) )
+            throw malformed("Expected a benchmark name and item count");
+        std::vector<double> nsPerItemLst;
+        for(double nsPerItem; lineStream>>nsPerItem;)
+            nsPerItemLst.push_back(nsPerItem);
+        if(nsPerItemLst.empty() || !lineStream.eof() )
+            throw malformed("Expected the samples of " + name);
+        baseline.push_back(makeResult(name, itemCount, std::move(nsPerItemLst) ) );
+    }
+    return baseline;
+}
+
+void saveBaseline(const std::filesystem::path& path, const Baseline& baseline) {
+    std::ofstream file{path};
+    if(!file)
+        throw std::runtime_error("Can't open the baseline: " + path.string() );
+    file<<"# dodge_it_bench baseline, made with: dodge_it_bench --save-baseline <path>\n";
+    file<<"# <name> <item count> <ns per item of every sample>...\n";
+    file<<"version "<<baselineVersion<<'\n';
+    file<<std::setprecision(std::numeric_limits<double>::max_digits10);
+    for(const auto& result : baseline) {
+        file<<result.name<<' '<<result.itemCount;
+        for(const double nsPerItem : result.nsPerItemLst)
+            file<<' '<<nsPerItem;
+        file<<'\n';
+    }
+    if(!file)
+        throw std::runtime_error("Can't write the baseline: " + path.string() );
+}
+
+void mergeIntoBaseline(Baseline& baseline, const std::vector<Result>& resultLst) {
+    for(const auto& result : resultLst) {
+        const auto iter = std::find_if(baseline.begin(), baseline.end(), [&result](const Result& entry){
+            return entry.name == result.name;
+        });
+        if(iter != baseline.end() )
+            *iter = result;
+        else
+            baseline.push_back(result);
+    }
+}
+
+
+double mannWhitneyPValue(std::span<const double> before, std::span<const double> after) {
+    const size_t beforeCount = before.size();
+    const size_t afterCount = after.size();
+    if(beforeCount == 0 || afterCount == 0)
+        return 1.0;
+
+    // Rank every sample together, tied samples get the mean of their ranks
+    struct Sample {
+        double value;
+        bool isAfter;
+    };
+    std::vector<Sample> sampleLst;
+    for(const double value : before)
+        sampleLst.push_back({value, false});
+    for(const double value : after)
+        sampleLst.push_back({value, true});
+    std::sort(sampleLst.begin(), sampleLst.end(), [](const Sample& lhs, const Sample& rhs){
+        return lhs.value < rhs.value;
+    });
+
+    const auto totalCount = static_cast<double>(sampleLst.size() );
+    double afterRankSum = 0;
+    double tieCorrection = 0; // sum of t^3 - t over the groups of t tied samples
+    for(size_t first = 0; first < sampleLst.size();) {
+        size_t last = first + 1;
+        // The samples are sorted, so the ones that aren't larger are equal
+        while(last < sampleLst.size() && !(sampleLst[first].value < sampleLst[last].value))
+            ++last;
+        const auto tieCount = static_cast<double>(last - first);
+        const double meanRank = static_cast<double>(first + last + 1) / 2; // ranks start at 1
+        for(size_t i = first; i < last; ++i) {
+            if(sampleLst[i].isAfter)
+                afterRankSum += meanRank;
+        }
+        tieCorrection += tieCount * tieCount * tieCount - tieCount;
+        first = last;
+    }
+
+    const auto n1 = static_cast<double>(afterCount);
+    const auto n2 = static_cast<double>(beforeCount);
+    const double u = afterRankSum - n1 * (n1 + 1) / 2;
+    const double mean = n1 * n2 / 2;
+    const double variance = n1 * n2 / 12 * ( (totalCount + 1) - tieCorrection / (totalCount * (totalCount - 1) ) );
+    if(variance <= 0)
+        return 1.0;
+    // With a continuity correction
+    const double z = (u - mean - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0) );
+}
+
+
+Comparison compareWithBaseline(std::ostream& os, const Baseline& baseline, const std::vector<Result>& resultLst,
+                               const RegressionOptions& options)
+{
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os<<std::left<<std::setw(44)<<"benchmark"<<std::right
+      <<std::setw(14)<<"baseline ns"<<std::setw(14)<<"new ns"<<std::setw(10)<<"change"<<std::setw(10)<<"p-value"
+      <<"  status\n";
+
+    Comparison comparison{};
+    for(const auto& result : resultLst) {
+        os<<std::left<<std::setw(44)<<result.name<<std::right<<std::fixed<<std::setprecision(3);
+        const Result* baselineResult = findResult(baseline, result.name);
+        if(!baselineResult || baselineResult->itemCount != result.itemCount) {
+            os<<std::setw(14)<<"-"<<std::setw(14)<<result.medianNsPerItem<<std::setw(10)<<"-"<<std::setw(10)<<"-"
+              <<(baselineResult ? "  changed" : "  new")<<'\n';
+            ++comparison.unmatchedCount;
+            continue;
+        }
+
+        const double change = result.medianNsPerItem / baselineResult->medianNsPerItem - 1;
+        const double slowerPValue = mannWhitneyPValue(baselineResult->nsPerItemLst, result.nsPerItemLst);
+        const double fasterPValue = mannWhitneyPValue(result.nsPerItemLst, baselineResult->nsPerItemLst);
+        const bool isRegression = slowerPValue <= options.significance && change > options.threshold;
+        const bool isImprovement = fasterPValue <= options.significance && -change > options.threshold;
+        comparison.regressionCount += isRegression;
+
+        os<<std::setw(14)<<baselineResult->medianNsPerItem<<std::setw(14)<<result.medianNsPerItem
+          <<std::setprecision(1)<<std::showpos<<std::setw(9)<<change * 100<<'%'<<std::noshowpos
+          <<std::setprecision(4)<<std::setw(10)<<std::min(slowerPValue, fasterPValue)
+          <<(isRegression ? "  REGRESSION" : isImprovement ? "  faster" : "  ok")<<'\n';
+    }
+    os.flags(flags);
+    os.precision(precision);
+    return comparison;
+}
+
+
+} // namespace Bench
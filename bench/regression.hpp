@@ -0,0 +1,69 @@
+
+#ifndef HPP_BENCH_REGRESSION_
+#define HPP_BENCH_REGRESSION_
+
+#include "benchmark.hpp"
+
+#include <filesystem>
+#include <iosfwd>
+#include <span>
+#include <vector>
+
+
+namespace Bench
+{
+
+
+/**
+ * @brief Results that new runs are compared against, stored as text so that they can be reviewed in diffs
+ * @note Format:   # comments
+ *                 version 1
+ *                 <name> <item count> <ns per item of every sample>...
+ */
+using Baseline = std::vector<Result>;
+
+/**
+ * @brief Load a baseline, an empty baseline is returned if the file doesn't exist
+ * @throws runtime_error if the file can't be read, has a different version or is malformed
+ */
+[[nodiscard]] Baseline loadBaseline(const std::filesystem::path& path);
+/**
+ * @throws runtime_error if the file can't be written
+ */
+void saveBaseline(const std::filesystem::path& path, const Baseline& baseline);
+
+/**
+ * @brief Replace the entries of the baseline that have the same name as a result, and add the others
+ */
+void mergeIntoBaseline(Baseline& baseline, const std::vector<Result>& resultLst);
+
+
+/**
+ * @brief The one-sided Mann-Whitney U test, using the normal approximation with a tie correction
+ * @return the p-value of the samples in after not tending to be larger than the samples in before,
+ *         so a small p-value means that after is significantly slower
+ */
+[[nodiscard]] double mannWhitneyPValue(std::span<const double> before, std::span<const double> after);
+
+
+struct RegressionOptions {
+    double threshold = 0.05;    // The smallest relative increase of the median that is a regression
+    double significance = 0.01; // The largest p-value that is a regression
+};
+
+struct Comparison {
+    size_t regressionCount;
+    size_t unmatchedCount; // Results without a baseline, or with a different item count
+};
+
+/**
+ * @brief Print a table comparing each result with its baseline
+ * @note Unmatched results can't be regressions, so a gate should also check that there are none
+ */
+[[nodiscard]] Comparison compareWithBaseline(std::ostream& os, const Baseline& baseline, const std::vector<Result>& resultLst,
+                                             const RegressionOptions& options);
+
+
+} // namespace Bench
+
+#endif // ifndef HPP_BENCH_REGRESSION_
@@ -2,3 +2,12 @@
 option(ENABLE_ADDITIONAL_WARNING "Turn on some useful addtional warnings for developers." ON)
 
 option(ENABLE_WARNING_AS_ERROR "Treat warning as errors, for developers only." OFF)
+
+option(ENABLE_PROFILER "Record profiler zones and write a Chrome trace on exit." OFF)
+
+option(ENABLE_BENCHMARKS "Build dodge_it_bench, the micro-benchmarks of the hot paths." OFF)
+
+set(REAL_TYPE "float" CACHE STRING "The type of Util::Real, Util::Q32_32 makes the simulation bit-deterministic across platforms.")
+set_property(CACHE REAL_TYPE PROPERTY STRINGS "float" "double" "Util::Q32_32")
+
+option(ENABLE_ALLOCATION_TRACKING "Replace the global operator new and delete with ones that count allocations, always on in Debug." OFF)
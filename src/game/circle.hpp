@@ -41,7 +41,7 @@ struct Circle {
     }
 
     [[nodiscard]] constexpr Util::BaseRect aabb() const {
-        return Util::BaseRect::centreSize(centre, {radius*2.0f, radius*2.0f});
+        return Util::BaseRect::centreSize(centre, {radius*Util::Real{2}, radius*Util::Real{2}});
     }
 
     [[nodiscard]] constexpr Util::BasePositionScalar left() const {
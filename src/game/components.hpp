@@ -0,0 +1,52 @@
+
+#ifndef HPP_GAME_COMPONENTS_
+#define HPP_GAME_COMPONENTS_
+
+#include "circle.hpp"
+
+#include "../media/sprite.hpp"
+
+#include "../util/dimension.hpp"
+#include "../util/registry.hpp"
+#include "../util/vec2.hpp"
+
+
+namespace Game
+{
+
+
+// Circle is an entity's position and size, and Media::Sprite is its animation state
+
+struct Velocity {
+    Util::BaseVelocity value;
+};
+
+struct Mass {
+    Util::BaseMass value;
+};
+
+/**
+ * @brief Steers the entity towards the mouse at a constant speed, while it's following
+ */
+struct MouseFollower {
+    Util::BaseSpeed speed;
+    bool isFollowing = false;
+};
+
+// Tags, for the systems that only apply to some kinds of entity
+
+struct EnemyTag {};
+
+struct PlayerTag {};
+
+
+/**
+ * @brief Every object in the game is an entity with some of these components
+ * @note A new kind of object is a new combination of components, instead of a new class
+ */
+using World = Util::Registry<Circle, Velocity, Mass, Media::Sprite, MouseFollower, EnemyTag, PlayerTag>;
+
+
+} // namespace Game
+
+#endif // ifndef HPP_GAME_COMPONENTS_
@@ -0,0 +1,64 @@
+
+#include "entities.hpp"
+
+#include "../media/core.hpp"
+
+#include <array>
+
+
+namespace Game
+{
+
+
+using namespace Util::Udl;
+using namespace Media::Udl;
+
+
+namespace
+{
+
+
+constexpr Media::AnimationFrame enemyFrame{
+    .rect = Media::PixelRect::leftTopSize({64_pl, 0_pl}, {64_pl, 64_pl}),
+    .time = Media::forever,
+};
+constexpr Media::AnimationFrame playerFrame{
+    .rect = Media::PixelRect::leftTopSize({0_pl, 0_pl}, {64_pl, 64_pl}),
+    .time = Media::forever,
+};
+// Shared by every sprite, so that spawning doesn't copy them
+constexpr std::array<Media::Animation, 1> enemyAnimationLst{ {
+    {.modeName="default", .frameLst={enemyFrame} },
+} };
+constexpr std::array<Media::Animation, 1> playerAnimationLst{ {
+    {.modeName="default", .frameLst={playerFrame} },
+} };
+
+constexpr Util::BaseSpeed playerSpeed = 5_blPs;
+
+
+} // namespace
+
+
+Util::Entity spawnEnemy(World& world, SDL_Texture* texture, Circle circle) {
+    const Util::Entity entity = world.create();
+    world.emplace<Circle>(entity, circle);
+    world.emplace<Velocity>(entity, Util::BaseVelocity{4_blPs, -4_blPs});
+    world.emplace<Mass>(entity, 1_bm);
+    world.emplace<Media::Sprite>(entity, texture, enemyAnimationLst);
+    world.emplace<EnemyTag>(entity);
+    return entity;
+}
+
+Util::Entity spawnPlayer(World& world, SDL_Texture* texture) {
+    const Util::Entity entity = world.create();
+    world.emplace<Circle>(entity, Circle{.radius=1_bl, .centre={20_bl, 20_bl} });
+    world.emplace<Velocity>(entity, Util::BaseVelocity{0_blPs, 0_blPs});
+    world.emplace<Media::Sprite>(entity, texture, playerAnimationLst);
+    world.emplace<MouseFollower>(entity, playerSpeed);
+    world.emplace<PlayerTag>(entity);
+    return entity;
+}
+
+
+} // namespace Game
@@ -0,0 +1,28 @@
+
+#ifndef HPP_GAME_ENTITIES_
+#define HPP_GAME_ENTITIES_
+
+#include "circle.hpp"
+#include "components.hpp"
+
+#include <SDL2/SDL_render.h>
+
+
+namespace Game
+{
+
+
+/**
+ * @brief Create an enemy, which moves at a constant speed and bounces off the edges of the world
+ */
+Util::Entity spawnEnemy(World& world, SDL_Texture* texture, Circle circle);
+
+/**
+ * @brief Create the player, which follows the mouse while it's following
+ */
+Util::Entity spawnPlayer(World& world, SDL_Texture* texture);
+
+
+} // namespace Game
+
+#endif // ifndef HPP_GAME_ENTITIES_
@@ -1,19 +1,31 @@
 
 #include "playing_state.hpp"
 
+#include "entities.hpp"
+#include "systems.hpp"
+
 #include "../media/core.hpp"
 #include "../media/game_context.hpp"
 
 #include "../menu_states/game_over.hpp"
 
+#include "../util/allocation_tracking.hpp"
+#include "../util/format_buffer.hpp"
+#include "../util/memory_report.hpp"
+
 #include <SDL2/SDL_events.h>
 
+#include <array>
+#include <cmath>
+#include <cstring>
+
 
 namespace Game
 {
 
 
 using namespace Util::Udl;
+using namespace Media::Udl;
 
 
 namespace
@@ -24,28 +36,72 @@ namespace
 constexpr auto worldSize = static_cast<Util::BaseDisplacement>(Media::windowsSize);
 constexpr auto worldRect = Util::BaseRect::leftTopSize({0_bl, 0_bl}, worldSize);
 
+// The time survived is shown in the right-top corner
+constexpr Media::PixelPosition timerLeftTop = {Media::windowsSize.x - 96_pl, 8_pl};
+// Each of its characters is drawn as a quad, so there are at most capacity() of them
+using TimerText = Util::FormatBuffer<16>;
+
+// The number of ticks before update and draw are expected to stop allocating
+constexpr size_t allocationWarmupTickCount = 64;
+
+// The stress test's player circles around the centre of the world, so it keeps moving through the enemies
+Util::BasePosition getScriptedPlayerTarget(Util::Second time) {
+    constexpr Util::Real angularSpeed = 0.5_r; // radians per second
+    // The trigonometry is in float, even when Real is fixed-point
+    const auto angle = static_cast<float>(angularSpeed * time.value);
+    const Util::BaseDistance radius = worldRect.height() / 4_r;
+    return worldRect.centre() + Util::BaseDisplacement{radius * Util::Real{std::cos(angle)}, radius * Util::Real{std::sin(angle)}};
+}
+
+// FNV-1a over the bytes of the value, which are the same on every platform when Real is fixed-point
+void hashReal(uint64_t& hash, Util::Real value) {
+    std::array<unsigned char, sizeof(value)> bytes;
+    std::memcpy(bytes.data(), &value, sizeof(value) );
+    for(const unsigned char byte : bytes) {
+        hash ^= byte;
+        hash *= 0x100000001B3;
+    }
+}
+
+void hashCircle(uint64_t& hash, const Circle& circle) {
+    hashReal(hash, circle.x().value);
+    hashReal(hash, circle.y().value);
+    hashReal(hash, circle.r().value);
+}
+
 
 } // namespace
 
 
-PlayingState::PlayingState(Media::GameContext& ctx_) :
+PlayingState::PlayingState(Media::GameContext& ctx_, std::optional<StressConfig> stressConfig_) :
     Media::GameState{ctx_},
-    mEnemyLst{},
-    mPlayer{ctx_.resourceManager.getTexture("circles")},
-    mRng{},
+    mStressConfig{stressConfig_},
+    mWorld{},
+    mPlayer{spawnPlayer(mWorld, ctx_.resourceManager.getTexture("circles") )},
+    mRng{stressConfig_ ? Util::Rng{stressConfig_->seed} : Util::Rng{}},
     mTimeUntilEnemySpawn{0_s},
-    mTimeSurvived{0_s}
-{}
+    mTimeSurvived{0_s},
+    rFont{ctx_.resourceManager.getFont("andika")}
+{
+    if(mStressConfig) {
+        mWorld.reserve(mStressConfig->enemyCount + 1); // with the player
+        for(size_t i=0; i<mStressConfig->enemyCount; ++i)
+            spawnEnemy();
+        mWorld.get<MouseFollower>(mPlayer).isFollowing = true;
+    }
+}
 
 void PlayingState::handleInput() {
     SDL_Event ev;
     while(SDL_PollEvent(&ev) ) {
         switch(ev.type) {
         case SDL_MOUSEBUTTONDOWN:
-            mPlayer.startFollowingMouse();
+            if(!mStressConfig)
+                mWorld.get<MouseFollower>(mPlayer).isFollowing = true;
             break;
         case SDL_MOUSEBUTTONUP:
-            mPlayer.stopFollowingMouse();
+            if(!mStressConfig)
+                mWorld.get<MouseFollower>(mPlayer).isFollowing = false;
             break;
         case SDL_QUIT:
             rCtx.quit = true;
@@ -54,45 +110,70 @@ void PlayingState::handleInput() {
             break;
         }
     }
-    mPlayer.takeMousePosition(rCtx.window.mouseWorldCoord() );
+    const Util::BasePosition target = mStressConfig ? getScriptedPlayerTarget(mTimeSurvived)
+                                                    : rCtx.window.mouseWorldCoord();
+    FollowSystem{target}(mWorld);
 }
 
 void PlayingState::update(Util::Second dt) {
+    UTIL_FORBID_ALLOCATION("PlayingState::update", mTickCount >= allocationWarmupTickCount);
+    ++mTickCount;
     mTimeSurvived += dt;
 
-    for(auto& enemy : mEnemyLst) {
-        enemy.update(dt);
-        if(enemy.getCircle().top() <= worldRect.top() || enemy.getCircle().bottom() >= worldRect.bottom() )
-            enemy.applyImpulseY(-2.0f * enemy.getMomentumY() );
-        if(enemy.getCircle().left() <= worldRect.left() || enemy.getCircle().right() >= worldRect.right() )
-            enemy.applyImpulseX(-2.0f * enemy.getMomentumX() );
-
-        if(hasCollision(enemy.getCircle(), mPlayer.getCircle() ) ) {
-            auto nextState = std::make_unique<Menu::GameOverState>(rCtx, mTimeSurvived);
-            rCtx.stateMachine.addState(std::move(nextState) );
-        }
+    if(updateWorld(mWorld, mPlayer, worldRect, dt) && !mStressConfig) {
+        UTIL_ALLOW_ALLOCATION("PlayingState::gameOver");
+        auto nextState = std::make_unique<Menu::GameOverState>(rCtx, mTimeSurvived);
+        rCtx.stateMachine.addState(std::move(nextState) );
     }
 
-    mPlayer.update(dt);
-
     mTimeUntilEnemySpawn -= dt;
     if(mTimeUntilEnemySpawn <= 0_s) {
         mTimeUntilEnemySpawn = 5_s;
-        const Util::BaseDistance r{mRng.getFloat(0.25, 2.5)};
-        const Util::BasePositionScalar cx{mRng.getFloat(worldRect.left().value, worldRect.right().value)};
-        const Util::BasePositionScalar cy{mRng.getFloat(worldRect.top().value, worldRect.bottom().value)};
-        const Circle circle{.radius=r, .centre={cx, cy} };
-        mEnemyLst.emplace_back(rCtx.resourceManager.getTexture("circles"), circle);
+        spawnEnemy();
     }
 }
 
+size_t PlayingState::entityCount() const {
+    return mWorld.pool<EnemyTag>().size();
+}
+
+uint64_t PlayingState::simulationHash() const {
+    uint64_t hash = 0xCBF29CE484222325;
+    hashCircle(hash, mWorld.get<Circle>(mPlayer) );
+    mWorld.each<const EnemyTag, const Circle>([&hash](Util::Entity, const EnemyTag&, const Circle& circle) {
+        hashCircle(hash, circle);
+    });
+    return hash;
+}
+
+void PlayingState::reportMemory(Util::MemoryReport& report) const {
+    // The components are stored in a pool for each type, and the sprites' animations are shared
+    report.add("playing", "entities", mWorld.capacityBytes() );
+}
+
+void PlayingState::spawnEnemy() {
+    // The pools and the window's batches only grow here, so that the rest of the frame doesn't allocate
+    UTIL_ALLOW_ALLOCATION("PlayingState::spawnEnemy");
+    const Util::BaseDistance r{mRng.getFloat(0.25, 2.5)};
+    const Util::BasePositionScalar cx{mRng.getFloat(static_cast<float>(worldRect.left().value),
+                                                    static_cast<float>(worldRect.right().value) )};
+    const Util::BasePositionScalar cy{mRng.getFloat(static_cast<float>(worldRect.top().value),
+                                                    static_cast<float>(worldRect.bottom().value) )};
+    const Circle circle{.radius=r, .centre={cx, cy} };
+    Game::spawnEnemy(mWorld, rCtx.resourceManager.getTexture("circles"), circle);
+    // The timer's glyphs are drawn in the same batches, and a longer time mustn't make them grow in draw
+    rCtx.window.reserveQuads(mWorld.aliveCount() + TimerText::capacity() );
+}
+
 void PlayingState::draw() {
+    UTIL_FORBID_ALLOCATION("PlayingState::draw", mTickCount >= allocationWarmupTickCount);
     auto& window = rCtx.window;
     window.clear();
-    for(const auto& enemy : mEnemyLst)
-        window.draw(enemy);
-    window.draw(mPlayer);
-    window.display();
+    drawWorld(mWorld, window);
+
+    // Formatted into a fixed buffer every frame, so that it doesn't allocate
+    TimerText timeText;
+    window.draw(rFont, timerLeftTop, timeText.append(mTimeSurvived, {.precision = 1}) );
 }
 
 
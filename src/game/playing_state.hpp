@@ -2,34 +2,54 @@
 #ifndef HPP_GAME_PLAYINGSTATE_
 #define HPP_GAME_PLAYINGSTATE_
 
-#include "enemy.hpp"
-#include "player.hpp"
+#include "components.hpp"
 
 #include "../media/game_state.hpp"
 
 #include "../util/rng.hpp"
 
-#include <vector>
+#include <SDL_FontCache/SDL_FontCache.h>
+
+#include <optional>
 
 
 namespace Game
 {
 
 
+/**
+ * @brief How the game is changed for a stress test
+ * @note The player follows a scripted path instead of the mouse, and colliding doesn't end the game
+ */
+struct StressConfig {
+    size_t enemyCount; // Spawned at the start
+    uint32_t seed;
+};
+
+
 class PlayingState : public Media::GameState {
 public:
-    explicit PlayingState(Media::GameContext& ctx_);
+    explicit PlayingState(Media::GameContext& ctx_, std::optional<StressConfig> stressConfig_ = std::nullopt);
 
     void handleInput() override;
     void update(Util::Second dt) override;
     void draw() override;
+    [[nodiscard]] size_t entityCount() const override;
+    [[nodiscard]] uint64_t simulationHash() const override;
+    void reportMemory(Util::MemoryReport& report) const override;
 
 private:
-    std::vector<Enemy> mEnemyLst{};
-    Player mPlayer;
+    void spawnEnemy();
+
+    std::optional<StressConfig> mStressConfig;
+    // Allocating in update or draw is forbidden after the warm-up, when allocation tracking is enabled
+    size_t mTickCount{};
+    World mWorld{};
+    Util::Entity mPlayer;
     Util::Rng mRng{};
     Util::Second mTimeUntilEnemySpawn{};
     Util::Second mTimeSurvived{};
+    FC_Font* rFont{};
 };
 
 
@@ -0,0 +1,240 @@
+
+#include "stress_test.hpp"
+
+#include "playing_state.hpp"
+
+#include "../util/allocation_tracking.hpp"
+#include "../util/frame_arena.hpp"
+#include "../util/frame_stats.hpp"
+#include "../util/memory_report.hpp"
+#include "../util/process_memory.hpp"
+#include "../util/project_info.hpp"
+
+#include <SDL2/SDL_hints.h>
+#include <SDL2/SDL_stdinc.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+
+namespace Game
+{
+
+
+using namespace std::string_literals;
+
+
+const char* const stressTestUsage =
+    "Usage: dodge_it --stress [--enemies N] [--ticks N] [--seed N] [--json PATH] [--render | --headless]";
+
+
+namespace
+{
+
+
+template<typename T>
+T parseInteger(std::string_view option, std::string_view value) {
+    T result{};
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if(error != std::errc{} || end != value.data() + value.size() )
+        throw std::runtime_error("Invalid value for "s + std::string(option) + ": " + std::string(value) );
+    return result;
+}
+
+struct StressTestResults {
+    uint64_t tickCount;
+    size_t entityCount;
+    uint64_t simulationHash;
+    Util::Second elapsedTime;
+    Util::AllocationStats allocationStats; // During the ticks
+    Util::MemoryReport memoryReport;       // After the ticks
+};
+
+void writeSummaryJson(std::ostream& os, const Util::LatencySummary& summary) {
+    constexpr Util::Real msPerSecond = 1000;
+    os<<"{\"count\": "<<summary.sampleCount
+      <<", \"p50Ms\": "<<summary.p50.value * msPerSecond
+      <<", \"p95Ms\": "<<summary.p95.value * msPerSecond
+      <<", \"p99Ms\": "<<summary.p99.value * msPerSecond
+      <<", \"maxMs\": "<<summary.max.value * msPerSecond<<'}';
+}
+
+void writeMemoryJson(std::ostream& os, const Util::MemoryReport& memoryReport) {
+    // The subsystems and names are fixed or asset keys, so they don't need escaping
+    os<<"{\"totalBytes\": "<<memoryReport.totalBytes()<<", \"entries\": [";
+    bool isFirst = true;
+    for(const auto& entry : memoryReport.entryLst() ) {
+        os<<(isFirst ? "\n" : ",\n")<<"    {\"subsystem\": \""<<entry.subsystem<<"\", \"name\": \""<<entry.name
+          <<"\", \"bytes\": "<<entry.bytes<<'}';
+        isFirst = false;
+    }
+    os<<"\n  ]}";
+}
+
+void writeResultsJson(std::ostream& os, const StressTestOptions& options,
+                      const StressTestResults& results, const Util::FrameStats& frameStats)
+{
+    os<<"{\n";
+    os<<"  \"version\": \""<<Util::projectVersion()<<"\",\n";
+    os<<"  \"enemies\": "<<options.enemyCount<<",\n";
+    os<<"  \"ticks\": "<<results.tickCount<<",\n";
+    os<<"  \"seed\": "<<options.seed<<",\n";
+    os<<"  \"render\": "<<(options.isRendering ? "true" : "false")<<",\n";
+    os<<"  \"finalEntities\": "<<results.entityCount<<",\n";
+    // A string, as JSON numbers lose the low bits of a 64 bit hash
+    os<<"  \"simulationHash\": \""<<std::hex<<std::setfill('0')<<std::setw(16)<<results.simulationHash
+      <<std::setfill(' ')<<std::dec<<"\",\n";
+    os<<"  \"elapsedSeconds\": "<<results.elapsedTime.value<<",\n";
+    const Util::Real ticksPerSecond = static_cast<Util::Real>(results.tickCount) / results.elapsedTime.value;
+    os<<"  \"ticksPerSecond\": "<<ticksPerSecond<<",\n";
+
+    os<<"  \"phases\": {";
+    bool isFirst = true;
+    for(size_t i=0; i<Util::framePhaseCount; ++i) {
+        const auto phase = static_cast<Util::FramePhase>(i);
+        const auto summary = frameStats.totalSummary(phase);
+        if(summary.sampleCount == 0)
+            continue;
+        os<<(isFirst ? "\n" : ",\n")<<"    \""<<Util::toString(phase)<<"\": ";
+        writeSummaryJson(os, summary);
+        isFirst = false;
+    }
+    os<<"\n  },\n";
+
+    os<<"  \"peakResidentBytes\": ";
+    if(const auto peakResident = Util::peakResidentBytes() )
+        os<<*peakResident;
+    else
+        os<<"null";
+    os<<",\n";
+
+    os<<"  \"memory\": ";
+    writeMemoryJson(os, results.memoryReport);
+    os<<",\n";
+
+    os<<"  \"allocations\": ";
+    if(Util::isAllocationTrackingEnabled() ) {
+        os<<"{\"count\": "<<results.allocationStats.allocationCount
+          <<", \"deallocations\": "<<results.allocationStats.deallocationCount
+          <<", \"bytes\": "<<results.allocationStats.allocatedBytes<<'}';
+    } else {
+        os<<"null";
+    }
+    os<<"\n}\n";
+}
+
+
+} // namespace
+
+
+std::optional<StressTestOptions> parseStressTestOptions(std::span<const char* const> argLst) {
+    // Without --stress the arguments aren't ours, e.g. a launcher can pass its own
+    if(std::ranges::find(argLst, std::string_view{"--stress"}) == argLst.end() )
+        return std::nullopt;
+
+    StressTestOptions options{};
+    for(size_t i=0; i<argLst.size(); ++i) {
+        const std::string_view arg = argLst[i];
+        const auto getValue = [&]() -> std::string_view {
+            if(i + 1 >= argLst.size() )
+                throw std::runtime_error("Missing value for "s + std::string(arg) );
+            return argLst[++i];
+        };
+
+        if(arg == "--stress")
+            continue;
+        else if(arg == "--enemies")
+            options.enemyCount = parseInteger<size_t>(arg, getValue() );
+        else if(arg == "--ticks")
+            options.tickCount = parseInteger<uint64_t>(arg, getValue() );
+        else if(arg == "--seed")
+            options.seed = parseInteger<uint32_t>(arg, getValue() );
+        else if(arg == "--json")
+            options.jsonPath = getValue();
+        else if(arg == "--render")
+            options.isRendering = true;
+        else if(arg == "--headless")
+            options.isRendering = false;
+        else
+            throw std::runtime_error("Unknown argument: "s + std::string(arg) );
+    }
+    return options;
+}
+
+void useStressTestDrivers(const StressTestOptions& options) {
+    // The environment variables are used since older SDL versions don't have hints for these
+    SDL_setenv("SDL_VIDEODRIVER", options.isRendering ? "offscreen" : "dummy", 1);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+}
+
+void runStressTest(Media::GameContext& ctx, const StressTestOptions& options, Util::Second tickDuration) {
+    using std::chrono::steady_clock;
+    const auto secondsBetween = [](steady_clock::time_point startTime, steady_clock::time_point endTime) {
+        return Util::fromChrono<Util::Real, Util::BaseRatio>(endTime - startTime);
+    };
+
+    ctx.stateMachine.addState(std::make_unique<PlayingState>(ctx, StressConfig{options.enemyCount, options.seed}) );
+    ctx.stateMachine.processStateChanges();
+    auto& state = ctx.stateMachine.getActiveState();
+    // Too large for the stack of some platforms
+    const auto frameStats = std::make_unique<Util::FrameStats>();
+
+    const auto allocationStatsBefore = Util::allocationStats();
+    const auto startTime = steady_clock::now();
+    uint64_t tickCount = 0;
+    for(; tickCount < options.tickCount && !ctx.quit; ++tickCount) {
+        const auto tickStartTime = steady_clock::now();
+        state.handleInput();
+        const auto inputEndTime = steady_clock::now();
+        state.update(tickDuration);
+        const auto tickEndTime = steady_clock::now();
+        frameStats->record(Util::FramePhase::input, secondsBetween(tickStartTime, inputEndTime) );
+        frameStats->record(Util::FramePhase::update, secondsBetween(inputEndTime, tickEndTime) );
+        frameStats->record(Util::FramePhase::tick, secondsBetween(tickStartTime, tickEndTime) );
+
+        if(options.isRendering) {
+            state.draw();
+            const auto drawEndTime = steady_clock::now();
+            ctx.window.display();
+            frameStats->record(Util::FramePhase::draw, secondsBetween(tickEndTime, drawEndTime) );
+            frameStats->record(Util::FramePhase::present, secondsBetween(drawEndTime, steady_clock::now() ) );
+        }
+        frameStats->record(Util::FramePhase::frame, secondsBetween(tickStartTime, steady_clock::now() ) );
+        Util::defaultFrameArenas().advanceFrame();
+    }
+    const auto elapsedTime = secondsBetween(startTime, steady_clock::now() );
+    const auto allocationStatsAfter = Util::allocationStats();
+
+    const StressTestResults results{
+        tickCount,
+        state.entityCount(),
+        state.simulationHash(),
+        elapsedTime,
+        {
+            allocationStatsAfter.allocationCount - allocationStatsBefore.allocationCount,
+            allocationStatsAfter.deallocationCount - allocationStatsBefore.deallocationCount,
+            allocationStatsAfter.allocatedBytes - allocationStatsBefore.allocatedBytes,
+        },
+        Media::reportMemory(ctx),
+    };
+    if(options.jsonPath.empty() ) {
+        writeResultsJson(std::cout, options, results, *frameStats);
+        return;
+    }
+    std::ofstream file{options.jsonPath};
+    if(!file)
+        throw std::runtime_error("Can't open the stress test results file: " + options.jsonPath.string() );
+    writeResultsJson(file, options, results, *frameStats);
+}
+
+
+} // namespace Game
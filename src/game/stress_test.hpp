@@ -0,0 +1,56 @@
+
+#ifndef HPP_GAME_STRESS_TEST_
+#define HPP_GAME_STRESS_TEST_
+
+#include "../media/game_context.hpp"
+
+#include "../util/dimension.hpp"
+#include "../util/typedefs.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <span>
+
+
+namespace Game
+{
+
+
+/**
+ * @brief How the game was asked to run a stress test, from the command line
+ * @example dodge_it --stress --enemies 100000 --ticks 10000 --seed 42 --json out.json
+ */
+struct StressTestOptions {
+    size_t enemyCount = 10000;
+    uint64_t tickCount = 10000;
+    uint32_t seed = 42;
+    bool isRendering = true;          // --render (default) or --headless
+    std::filesystem::path jsonPath{}; // The results are written to stdout if it's empty
+};
+
+extern const char* const stressTestUsage;
+
+/**
+ * @brief Parse the command line arguments, not including the program name
+ * @return nullopt if --stress isn't one of the arguments, then the other arguments are ignored
+ * @throws runtime_error if an argument is unknown or a value is invalid, only with --stress
+ */
+[[nodiscard]] std::optional<StressTestOptions> parseStressTestOptions(std::span<const char* const> argLst);
+
+/**
+ * @brief Make SDL use drivers that don't need a display or sound device
+ * @note Must be called before SDL_Init. With rendering, the offscreen video driver and the software renderer are used
+ */
+void useStressTestDrivers(const StressTestOptions& options);
+
+/**
+ * @brief Run the playing state for the given number of ticks as fast as possible, then write the results as JSON
+ * @note Each iteration runs one tick, and is drawn and presented only when rendering
+ * @throws runtime_error if the results cannot be written
+ */
+void runStressTest(Media::GameContext& ctx, const StressTestOptions& options, Util::Second tickDuration);
+
+
+} // namespace Game
+
+#endif // ifndef HPP_GAME_STRESS_TEST_
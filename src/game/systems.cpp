@@ -0,0 +1,87 @@
+
+#include "systems.hpp"
+
+#include "../media/window.hpp"
+
+#include "../util/profiler.hpp"
+
+
+namespace Game
+{
+
+
+using namespace Util::Udl;
+
+
+// Each pair of the systems of a tick writes a component that the other one uses, so they run one after another
+static_assert(Util::systemsConflict<EnemySystem, MoveSystem>, "Both write the circles");
+static_assert(Util::systemsConflict<EnemySystem, FollowSystem>, "Both write the velocities");
+static_assert(Util::systemsConflict<MoveSystem, FollowSystem>, "The followers' circles are moved and read");
+
+
+void EnemySystem::operator()(World& world) const {
+    UTIL_PROFILE_ZONE("EnemySystem");
+    bool hasCollided = false;
+    world.each<const EnemyTag, const Mass, Circle, Velocity>(
+        [&](Util::Entity, const EnemyTag&, const Mass& mass, Circle& circle, Velocity& velocity) {
+            circle.centre += velocity.value * dt;
+            auto& [velX, velY] = velocity.value;
+            if(circle.top() <= worldRect.top() || circle.bottom() >= worldRect.bottom() )
+                velY += (-2_r * (mass.value * velY) ) / mass.value;
+            if(circle.left() <= worldRect.left() || circle.right() >= worldRect.right() )
+                velX += (-2_r * (mass.value * velX) ) / mass.value;
+
+            if(hasCollision(circle, playerCircle) )
+                hasCollided = true;
+        }
+    );
+    hasHitPlayer = hasCollided;
+}
+
+void MoveSystem::operator()(World& world) const {
+    UTIL_PROFILE_ZONE("MoveSystem");
+    world.each<const MouseFollower, Circle, const Velocity>(
+        [dt = dt](Util::Entity, const MouseFollower&, Circle& circle, const Velocity& velocity) {
+            circle.centre += velocity.value * dt;
+        }
+    );
+}
+
+void FollowSystem::operator()(World& world) const {
+    UTIL_PROFILE_ZONE("FollowSystem");
+    world.each<const MouseFollower, const Circle, Velocity>(
+        [this](Util::Entity, const MouseFollower& follower, const Circle& circle, Velocity& velocity) {
+            if(!follower.isFollowing)
+                return;
+            const auto disp = target - circle.centre;
+            // The target can be exactly on the centre, which unit() would turn into NaN
+            velocity.value = disp.unitFast() * follower.speed;
+        }
+    );
+}
+
+bool updateWorld(World& world, Util::Entity player, const Util::BaseRect& worldRect, Util::Second dt) {
+    bool hasHitPlayer = false;
+    EnemySystem{worldRect, dt, world.get<Circle>(player), hasHitPlayer}(world);
+    MoveSystem{dt}(world);
+    return hasHitPlayer;
+}
+
+void drawWorld(const World& world, Media::Window& window) {
+    window.beginSprites(world.pool<EnemyTag>().size(), Media::DrawLayer::world);
+    world.each<const EnemyTag, const Media::Sprite, const Circle>(
+        [&](Util::Entity, const EnemyTag&, const Media::Sprite& sprite, const Circle& circle) {
+            window.addSprite(sprite, circle.aabb() );
+        }
+    );
+    window.endSprites();
+
+    world.each<const PlayerTag, const Media::Sprite, const Circle>(
+        [&](Util::Entity, const PlayerTag&, const Media::Sprite& sprite, const Circle& circle) {
+            window.draw(sprite, circle.aabb(), Media::DrawLayer::foreground);
+        }
+    );
+}
+
+
+} // namespace Game
@@ -0,0 +1,78 @@
+
+#ifndef HPP_GAME_SYSTEMS_
+#define HPP_GAME_SYSTEMS_
+
+#include "components.hpp"
+
+#include "../util/dimension.hpp"
+#include "../util/rect.hpp"
+#include "../util/registry.hpp"
+#include "../util/vec2.hpp"
+
+
+namespace Media
+{
+class Window;
+} // namespace Media
+
+
+namespace Game
+{
+
+
+/**
+ * @brief Move the enemies, bounce them off the edges of the world by reversing their momentum,
+ *        and check if any of them hits the player
+ * @note It's a single pass over the enemies, as it's the hot loop of every tick
+ */
+struct EnemySystem {
+    using Reads = Util::TypeList<EnemyTag, Mass>;
+    using Writes = Util::TypeList<Circle, Velocity>;
+
+    Util::BaseRect worldRect;
+    Util::Second dt;
+    Circle playerCircle;
+    bool& hasHitPlayer;
+
+    void operator()(World& world) const;
+};
+
+/**
+ * @brief Move the mouse followers by their velocity, they don't bounce
+ */
+struct MoveSystem {
+    using Reads = Util::TypeList<MouseFollower, Velocity>;
+    using Writes = Util::TypeList<Circle>;
+
+    Util::Second dt;
+
+    void operator()(World& world) const;
+};
+
+/**
+ * @brief Steer the mouse followers that are following towards the target
+ */
+struct FollowSystem {
+    using Reads = Util::TypeList<MouseFollower, Circle>;
+    using Writes = Util::TypeList<Velocity>;
+
+    Util::BasePosition target;
+
+    void operator()(World& world) const;
+};
+
+/**
+ * @brief Run the systems of a tick, the enemies are checked against the player before it moves
+ * @return true if any of the enemies collided with the player
+ */
+bool updateWorld(World& world, Util::Entity player, const Util::BaseRect& worldRect, Util::Second dt);
+
+/**
+ * @brief Draw the enemies in bulk, and the player in front of them
+ */
+void drawWorld(const World& world, Media::Window& window);
+
+
+} // namespace Game
+
+#endif // ifndef HPP_GAME_SYSTEMS_
@@ -1,12 +1,19 @@
 
 #include "game/playing_state.hpp"
+#include "game/stress_test.hpp"
 
 #include "media/game_context.hpp"
 #include "media/game_state_machine.hpp"
+#include "media/performance_hud.hpp"
 #include "media/resource_manager.hpp"
 #include "media/window.hpp"
 
+#include "util/allocation_tracking.hpp"
 #include "util/dimension.hpp"
+#include "util/frame_arena.hpp"
+#include "util/frame_stats.hpp"
+#include "util/hitch_detector.hpp"
+#include "util/profiler.hpp"
 #include "util/project_info.hpp"
 
 #include <SDL2/SDL.h>
@@ -20,18 +27,43 @@
     #include <Windows.h>
 #endif // ifdef platform
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <optional>
+#include <stdexcept>
 
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
+int main(int argc, char** argv) {
     using namespace Util::Udl;
     using namespace std::chrono;
 
     std::cout<<Util::projectName()<<" ; "<<Util::projectVersion()<<std::endl;
 
+    // The only command line arguments are for the stress test, the others are ignored without --stress
+    std::optional<Game::StressTestOptions> stressTestOptions = std::nullopt;
+    try {
+        stressTestOptions = Game::parseStressTestOptions({argv + 1, static_cast<size_t>(argc - 1)});
+    } catch(const std::exception& e) {
+        std::cerr<<e.what()<<'\n'<<Game::stressTestUsage<<std::endl;
+        return EXIT_FAILURE;
+    }
+    if(stressTestOptions)
+        Game::useStressTestDrivers(*stressTestOptions);
+
+#ifdef UTIL_ENABLE_PROFILER
+    // The trace of the last zones is written when the game exits
+    Util::Profiler::setThreadName("main");
+    std::atexit([]{
+        try {
+            Util::Profiler::exportChromeTrace("dodge_it_trace.json");
+        } catch(const std::exception& e) {
+            std::cerr<<e.what()<<std::endl;
+        }
+    });
+#endif // ifdef UTIL_ENABLE_PROFILER
+
     // Initialising phase
     {
         // SDL_Init returns 0 on success or a negative error code on failure
@@ -102,19 +134,55 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
 
     // Load basic assets
     sCtx->resourceManager.loadTexture(u8"images/circles.png", "circles");
+    sCtx->resourceManager.loadFont(u8"fonts/andika_regular.ttf", "andika");
+
+    // Fixed time step
+    constexpr static Util::Hertz idealTickRate = 64_hz;
+    constexpr static Util::Second idealTickDuration = 1_r / idealTickRate;
+
+    // The stress test runs instead of the game
+    if(stressTestOptions) {
+        try {
+            Game::runStressTest(*sCtx, *stressTestOptions, idealTickDuration);
+        } catch(const std::exception& e) {
+            std::cerr<<e.what()<<std::endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
 
     // Initial state
     sCtx->stateMachine.addState(std::make_unique<Game::PlayingState>(*sCtx) );
     sCtx->stateMachine.processStateChanges();
 
     // Game loop variables
-    constexpr static Util::Hertz idealTickRate = 64_hz;
-    constexpr static Util::Second idealTickDuration = 1_r / idealTickRate;
     static Util::Second sAccumulator = 0_s;
     static decltype(high_resolution_clock::now() ) sCurrentTime{};
+    static Media::PerformanceHud sPerformanceHud{sCtx->resourceManager.getFont("andika")};
+    static Util::FrameStats sFrameStats;
+    static Util::HitchDetector sHitchDetector{2_r * idealTickDuration};
+    constexpr static auto writeReports = []{
+        sFrameStats.writeSummary(std::cout);
+        if(Util::isAllocationTrackingEnabled() )
+            Util::writeAllocationScopes(std::cout);
+        if(sCtx)
+            Media::reportMemory(*sCtx).write(std::cout);
+        if(sHitchDetector.hitchCount() == 0)
+            return;
+        try {
+            sHitchDetector.writeRecords("dodge_it_hitches.txt");
+        } catch(const std::exception& e) {
+            std::cerr<<e.what()<<std::endl;
+        }
+    };
+
+    // The frame statistics, the memory and the hitches are written when the game exits, or on SIGUSR1
+    std::atexit(writeReports);
+    Util::FrameStats::installSignalHandler();
 
     // Game loop function
     constexpr static auto gameLoop = []{
+        UTIL_PROFILE_ZONE("frame");
         assert(sCtx);
         auto& stateMachine = sCtx->stateMachine;
         auto& currentState = stateMachine.getActiveState();
@@ -122,13 +190,88 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
         const auto actualTickDuration = Util::fromChrono<Util::Real, Util::BaseRatio>(newTime - sCurrentTime);
         sCurrentTime = newTime;
         sAccumulator += actualTickDuration;
+        const auto secondsSince = [](auto startTime) {
+            return Util::fromChrono<Util::Real, Util::BaseRatio>(high_resolution_clock::now() - startTime);
+        };
+        const auto transitionCountBefore = stateMachine.transitionCount();
+        const auto loadStatsBefore = sCtx->resourceManager.loadStats();
+        const auto allocationStatsBefore = Util::allocationStats();
+        Util::FrameRecord frame{};
         while(sAccumulator >= idealTickDuration) {
+            UTIL_PROFILE_ZONE("tick");
+            ++frame.tickCount;
             sAccumulator -= idealTickDuration;
-            currentState.handleInput();
-            currentState.update(idealTickDuration);
+            const auto tickStartTime = high_resolution_clock::now();
+            {
+                UTIL_PROFILE_ZONE("handleInput");
+                UTIL_ALLOCATION_SCOPE("handleInput");
+                currentState.handleInput();
+            }
+            const auto inputEndTime = high_resolution_clock::now();
+            frame.inputTime += Util::fromChrono<Util::Real, Util::BaseRatio>(inputEndTime - tickStartTime);
+            {
+                UTIL_PROFILE_ZONE("update");
+                UTIL_ALLOCATION_SCOPE("update");
+                currentState.update(idealTickDuration);
+            }
+            frame.updateTime += secondsSince(inputEndTime);
+            const auto tickTime = secondsSince(tickStartTime);
+            frame.longestTickTime = std::max(frame.longestTickTime, tickTime);
+            sFrameStats.record(Util::FramePhase::tick, tickTime);
+        }
+        const auto tickTime = secondsSince(newTime);
+        frame.entityCount = currentState.entityCount();
+
+        auto& window = sCtx->window;
+        sPerformanceHud.handleToggleKey(Media::keyboardState() );
+        sPerformanceHud.record({
+            actualTickDuration,
+            tickTime,
+            frame.tickCount,
+            frame.entityCount,
+            window.lastRenderStats(),
+            // Only the ticks so far, since the sample is drawn in this frame
+            Util::allocationStats().allocationCount - allocationStatsBefore.allocationCount,
+            Util::defaultFrameArenas().previous().bytesUsed(),
+        });
+        const auto drawStartTime = high_resolution_clock::now();
+        {
+            UTIL_PROFILE_ZONE("draw");
+            UTIL_ALLOCATION_SCOPE("draw");
+            currentState.draw();
+            sPerformanceHud.draw(window);
+        }
+        const auto presentStartTime = high_resolution_clock::now();
+        frame.drawTime = Util::fromChrono<Util::Real, Util::BaseRatio>(presentStartTime - drawStartTime);
+        {
+            UTIL_ALLOCATION_SCOPE("display");
+            window.display();
+        }
+        frame.presentTime = secondsSince(presentStartTime);
+        {
+            UTIL_ALLOCATION_SCOPE("processStateChanges");
+            stateMachine.processStateChanges();
+        }
+        frame.frameTime = secondsSince(newTime);
+
+        const auto loadStats = sCtx->resourceManager.loadStats();
+        frame.stateTransitionCount = stateMachine.transitionCount() - transitionCountBefore;
+        frame.assetLoadCount = loadStats.loadCount - loadStatsBefore.loadCount;
+        frame.assetLoadTime = loadStats.loadTime - loadStatsBefore.loadTime;
+        sHitchDetector.record(frame);
+
+        // Frames without a tick would only add zeros to the input and update timings
+        if(frame.tickCount > 0) {
+            sFrameStats.record(Util::FramePhase::input, frame.inputTime);
+            sFrameStats.record(Util::FramePhase::update, frame.updateTime);
         }
-        currentState.draw();
-        stateMachine.processStateChanges();
+        sFrameStats.record(Util::FramePhase::draw, frame.drawTime);
+        sFrameStats.record(Util::FramePhase::present, frame.presentTime);
+        sFrameStats.record(Util::FramePhase::frame, frame.frameTime);
+        if(Util::FrameStats::pollSummaryRequest() )
+            writeReports();
+        // The scratch data of the frame before this one is freed
+        Util::defaultFrameArenas().advanceFrame();
     #ifdef __EMSCRIPTEN__
         if(sCtx->quit) {
             emscripten_cancel_main_loop();
@@ -1,6 +1,10 @@
 
 #include "camera.hpp"
 
+#include "../util/vec2x.hpp"
+
+#include <cassert>
+
 
 namespace Media
 {
@@ -12,7 +16,9 @@ using namespace Util;
 Camera::Camera(PixelDisplacement windowSize) :
     mWindowRect{PixelRect::leftTopSize({0_pl, 0_pl}, windowSize)},
     mViewRect{BaseRect::leftTopSize({0_bl, 0_bl}, static_cast<BaseDisplacement>(windowSize) )}
-{}
+{
+    updateTransform();
+}
 
 PixelRect Camera::getWindowBound() const {
     return mWindowRect;
@@ -22,24 +28,77 @@ BaseRect Camera::getViewBound() const {
     return mViewRect;
 }
 
+void Camera::setWindowBound(PixelRect windowRect_) {
+    mWindowRect = windowRect_;
+    updateTransform();
+}
+
+void Camera::setViewBound(Util::BaseRect viewRect_) {
+    mViewRect = viewRect_;
+    updateTransform();
+}
+
+BasePosition Camera::getViewOrigin() const {
+    return mViewOrigin;
+}
+
+Camera::ScreenScale Camera::getScreenScale() const {
+    return mScreenScale;
+}
+
+PixelPosition Camera::getScreenOffset() const {
+    return mScreenOffset;
+}
+
 bool Camera::isVisible(Util::BaseRect posRect) const {
     return hasCollision(mViewRect, posRect);
 }
 
 PixelPosition Camera::toScreenCoord(Util::BasePosition worldCoord) const {
-    const auto viewCoord = worldCoord - mViewRect.leftTop();
-    const auto relCoord = elemDiv(viewCoord, mViewRect.size() );
-    const auto screenCoord = elemMul(relCoord, mWindowRect.size() ) + mWindowRect.leftTop();
-    return screenCoord;
+    // Only the difference from the view is rounded to float, so the precision doesn't depend on the world size
+    const auto viewCoord = static_cast<RenderDisplacement>(worldCoord - mViewOrigin);
+    return elemMul(viewCoord, mScreenScale) + mScreenOffset;
 }
 
 BasePosition Camera::toWorldCoord(PixelPosition screenCoord) const {
-    const auto relCoord = elemDiv(screenCoord - mWindowRect.leftTop(), mWindowRect.size() );
-    const auto viewCoord = elemMul(relCoord, mViewRect.size() );
-    const auto worldCoord = viewCoord + mViewRect.leftTop();
-    return worldCoord;
+    const RenderDisplacement viewCoord = elemMul(screenCoord - mScreenOffset, mWorldScale);
+    return mViewOrigin + static_cast<BaseDisplacement>(viewCoord);
+}
+
+void Camera::toScreenCoords(std::span<const Util::BasePosition> worldCoordLst,
+                            std::span<PixelPosition> screenCoordLst) const
+{
+    assert(screenCoordLst.size() >= worldCoordLst.size() );
+    const size_t coordCount = worldCoordLst.size();
+    // Copies so that the compiler knows they don't alias the output
+    const BasePosition viewOrigin = mViewOrigin;
+    const ScreenScale screenScale = mScreenScale;
+    const PixelPosition screenOffset = mScreenOffset;
+    // A register of world coordinates at a time, with the same units and rounding as the scalar version
+    constexpr size_t laneCount = Util::defaultLaneCount<Util::Real>;
+    using WorldCoordX = Util::Vec2x<laneCount, Util::BasePositionScalar>;
+    using ViewCoordX = Util::Vec2x<laneCount, RenderDisplacement::Underlying>;
+    const auto viewOriginX = WorldCoordX::broadcast(viewOrigin);
+    const auto screenScaleX = Util::Vec2x<laneCount, ScreenScale::Underlying>::broadcast(screenScale);
+    const auto screenOffsetX = Util::Vec2x<laneCount, PixelPositionScalar>::broadcast(screenOffset);
+    size_t i = 0;
+    for(; i + laneCount <= coordCount; i += laneCount) {
+        const auto viewCoordX = static_cast<ViewCoordX>(WorldCoordX::load(worldCoordLst.data() + i) - viewOriginX);
+        (elemMul(viewCoordX, screenScaleX) + screenOffsetX).store(screenCoordLst.data() + i);
+    }
+    for(; i<coordCount; ++i) {
+        const auto viewCoord = static_cast<RenderDisplacement>(worldCoordLst[i] - viewOrigin);
+        screenCoordLst[i] = elemMul(viewCoord, screenScale) + screenOffset;
+    }
 }
 
+void Camera::updateTransform() {
+    const auto viewSize = static_cast<RenderDisplacement>(mViewRect.size() );
+    mViewOrigin = mViewRect.leftTop();
+    mScreenScale = elemDiv(mWindowRect.size(), viewSize);
+    mScreenOffset = mWindowRect.leftTop();
+    mWorldScale = elemDiv(viewSize, mWindowRect.size() );
+}
 
-} // namespace Media
 
+} // namespace Media
@@ -6,6 +6,9 @@
 
 #include "../util/rect.hpp"
 
+#include <span>
+#include <utility>
+
 
 namespace Media
 {
@@ -13,22 +16,50 @@ namespace Media
 
 /**
  * @brief Represents the viewable space
+ * @note The world-to-screen transform is cached, and is only recomputed when the view or window changes
+ * @note World coordinates are made relative to the view before they're rounded to the renderer's float,
+ *       so a large world with a double or fixed-point Util::Real keeps its precision far from the origin
  */
 class Camera
 {
 public:
+    using ScreenScale = decltype(elemDiv(std::declval<PixelDisplacement>(), std::declval<RenderDisplacement>() ) );
+
     explicit Camera(PixelDisplacement windowSize);
 
     PixelRect getWindowBound() const;
     Util::BaseRect getViewBound() const;
+    void setWindowBound(PixelRect windowRect_);
+    void setViewBound(Util::BaseRect viewRect_);
+
+    // toScreenCoord(worldCoord) == elemMul(worldCoord - getViewOrigin(), getScreenScale() ) + getScreenOffset()
+    [[nodiscard]] Util::BasePosition getViewOrigin() const;
+    [[nodiscard]] ScreenScale getScreenScale() const;
+    [[nodiscard]] PixelPosition getScreenOffset() const;
 
     [[nodiscard]] bool isVisible(Util::BaseRect posRect) const;
     [[nodiscard]] PixelPosition toScreenCoord(Util::BasePosition worldCoord) const;
     [[nodiscard]] Util::BasePosition toWorldCoord(PixelPosition screenCoord) const;
 
+    /**
+     * @brief Convert many world coordinates to screen coordinates at once
+     * @param screenCoordLst - where the results are stored, must be at least as large as worldCoordLst
+     */
+    void toScreenCoords(std::span<const Util::BasePosition> worldCoordLst, std::span<PixelPosition> screenCoordLst) const;
+
 private:
+    using WorldScale = decltype(elemDiv(std::declval<RenderDisplacement>(), std::declval<PixelDisplacement>() ) );
+
+    void updateTransform();
+
     PixelRect mWindowRect;
     Util::BaseRect mViewRect;
+    // screenCoord = elemMul(worldCoord - mViewOrigin, mScreenScale) + mScreenOffset
+    Util::BasePosition mViewOrigin{};
+    ScreenScale mScreenScale{};
+    PixelPosition mScreenOffset{};
+    // worldCoord = mViewOrigin + elemMul(screenCoord - mScreenOffset, mWorldScale)
+    WorldScale mWorldScale{};
 };
 
 
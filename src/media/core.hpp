@@ -22,14 +22,20 @@ using Util::Udl::operator""_r;
 
 
 // Typedefs
+
+// The renderer is always float, whatever Util::Real the simulation uses, see Camera::toScreenCoord
+using RenderReal = float;
+
 constexpr intmax_t defaultPixelsPerBlock = 32;
 using PixelRatio = std::ratio<1, defaultPixelsPerBlock>;
-using PixelLength = Util::Length<Util::Real, PixelRatio>;
-using PixelPositionScalar = Util::PositionScalar<Util::Real, PixelRatio>;
-using PixelDistance = Util::Distance<Util::Real, PixelRatio>;
-using PixelPosition = Util::Position<Util::Real, PixelRatio>;
-using PixelDisplacement = Util::Displacement<Util::Real, PixelRatio>;
-using PixelRect = Util::Rect<Util::Real, PixelRatio>;
+using PixelLength = Util::Length<RenderReal, PixelRatio>;
+using PixelPositionScalar = Util::PositionScalar<RenderReal, PixelRatio>;
+using PixelDistance = Util::Distance<RenderReal, PixelRatio>;
+using PixelPosition = Util::Position<RenderReal, PixelRatio>;
+using PixelDisplacement = Util::Displacement<RenderReal, PixelRatio>;
+using PixelRect = Util::Rect<RenderReal, PixelRatio>;
+// World distances in the renderer's precision, e.g. from the camera
+using RenderDisplacement = Util::Displacement<RenderReal, Util::BaseRatio>;
 
 // User-defined literals
 inline namespace Udl
@@ -37,11 +43,11 @@ inline namespace Udl
 
 
 [[nodiscard]] constexpr PixelLength operator"" _pl(long double f) noexcept {
-    return PixelLength{static_cast<Util::Real>(f)};
+    return PixelLength{static_cast<RenderReal>(f)};
 }
 
 [[nodiscard]] constexpr PixelLength operator"" _pl(unsigned long long int i) noexcept {
-    return PixelLength{static_cast<Util::Real>(i)};
+    return PixelLength{static_cast<RenderReal>(i)};
 }
 
 
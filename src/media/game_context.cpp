@@ -0,0 +1,23 @@
+
+#include "game_context.hpp"
+
+#include "../util/frame_arena.hpp"
+
+
+namespace Media
+{
+
+
+Util::MemoryReport reportMemory(const GameContext& ctx) {
+    Util::MemoryReport report;
+    ctx.resourceManager.reportMemory(report);
+    ctx.window.reportMemory(report);
+    ctx.stateMachine.reportMemory(report);
+    auto& frameArenas = Util::defaultFrameArenas();
+    report.add("frame arena", "current", frameArenas.current().capacity() );
+    report.add("frame arena", "previous", frameArenas.previous().capacity() );
+    return report;
+}
+
+
+} // namespace Media
@@ -7,6 +7,7 @@
 #include "window.hpp"
 
 #include "../util/dimension.hpp"
+#include "../util/memory_report.hpp"
 
 
 namespace Media
@@ -20,6 +21,11 @@ struct GameContext {
     bool quit{};
 };
 
+/**
+ * @brief The memory held by the resources, the window, the active state and the frame arenas
+ */
+[[nodiscard]] Util::MemoryReport reportMemory(const GameContext& ctx);
+
 
 } // namespace Media
 
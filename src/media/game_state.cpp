@@ -35,7 +35,6 @@ void GameState::update(Util::Second) {}
 void GameState::draw() {
     // A blank screen
     rCtx.window.clear();
-    rCtx.window.display();
 }
 
 
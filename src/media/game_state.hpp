@@ -5,6 +5,12 @@
 #include "../util/dimension.hpp"
 
 
+namespace Util
+{
+class MemoryReport;
+} // namespace Util
+
+
 namespace Media
 {
 
@@ -24,12 +30,17 @@ public:
     // These abstract methods must be implemented in the dervied classes
     virtual void handleInput() = 0;
     virtual void update(Util::Second) = 0;
+    // The window is displayed after draw(), so overlays can be drawn on top
     virtual void draw() = 0;
 
     // These virtual method are optional to implement
     virtual void init() {}
     virtual void pause() {}
     virtual void resume() {}
+    [[nodiscard]] virtual size_t entityCount() const { return 0; }
+    // A hash of the simulation's state, so that two runs can be checked for being bit identical
+    [[nodiscard]] virtual uint64_t simulationHash() const { return 0; }
+    virtual void reportMemory(Util::MemoryReport&) const {}
 
 protected:
     GameContext& rCtx; // GameContext will outlive the GameState
@@ -1,6 +1,8 @@
 
 #include "game_state_machine.hpp"
 
+#include "../util/profiler.hpp"
+
 #include <cassert>
 
 
@@ -19,11 +21,13 @@ void GameStateMachine::removeState() {
 
 void GameStateMachine::processStateChanges()
 {
+    UTIL_PROFILE_ZONE("processStateChanges");
     if(mIsRemoving && mStateStack.empty() ) {
         mStateStack.pop();
         if(!mStateStack.empty() )
             mStateStack.top()->resume();
         mIsRemoving = false;
+        ++mTransitionCount;
     }
 
     if(mStateToBeAdded) {
@@ -36,6 +40,7 @@ void GameStateMachine::processStateChanges()
         mStateStack.push(std::move(mStateToBeAdded) );
         mStateStack.top()->init();
         mIsReplacing = false;
+        ++mTransitionCount;
     }
 }
 
@@ -44,6 +49,15 @@ GameState& GameStateMachine::getActiveState() {
     return *mStateStack.top();
 }
 
+uint64_t GameStateMachine::transitionCount() const {
+    return mTransitionCount;
+}
+
+void GameStateMachine::reportMemory(Util::MemoryReport& report) const {
+    if(!mStateStack.empty() )
+        mStateStack.top()->reportMemory(report);
+}
+
 
 } // namespace Media
 
@@ -4,6 +4,8 @@
 
 #include "game_state.hpp"
 
+#include "../util/typedefs.hpp"
+
 #include <memory>
 #include <stack>
 
@@ -18,12 +20,17 @@ public:
     void removeState();
     void processStateChanges();
     GameState& getActiveState();
+    // The number of states that have been added or removed so far
+    [[nodiscard]] uint64_t transitionCount() const;
+    // Only the active state is reported, if there's one
+    void reportMemory(Util::MemoryReport& report) const;
 
 private:
     std::stack<std::unique_ptr<GameState> > mStateStack{};
     bool mIsReplacing = false;
     bool mIsRemoving = false;
     std::unique_ptr<GameState> mStateToBeAdded{};
+    uint64_t mTransitionCount{};
 };
 
 
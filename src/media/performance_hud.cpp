@@ -0,0 +1,126 @@
+
+#include "performance_hud.hpp"
+
+#include "core.hpp"
+
+#include "../util/allocation_tracking.hpp"
+#include "../util/format_buffer.hpp"
+
+#include <SDL2/SDL_keyboard.h>
+
+#include <algorithm>
+#include <cassert>
+#include <ratio>
+
+
+namespace Media
+{
+
+
+using namespace Util::Udl;
+using namespace Media::Udl;
+
+
+namespace
+{
+
+
+constexpr PixelPosition hudLeftTop = {8_pl, 8_pl};
+constexpr PixelLength barWidth = 2_pl;
+constexpr PixelLength graphHeight = 64_pl;
+// The top of the graph is this many ticks
+constexpr Util::Real graphTickCount = 4;
+// The graph is in the renderer's precision, whatever Util::Real is
+using RenderSecond = Util::Duration<RenderReal, Util::BaseRatio>;
+using Millisecond = Util::Duration<Util::Real, std::milli>;
+// Longer lines are cut off
+constexpr size_t lineCapacity = 64;
+constexpr Util::NumberFormat timeFormat = {.precision = 2, .width = 6};
+
+constexpr SDL_Colour onBudgetColour = {0x40, 0xC0, 0x40, SDL_ALPHA_OPAQUE};
+constexpr SDL_Colour overBudgetColour = {0xE0, 0xC0, 0x20, SDL_ALPHA_OPAQUE};
+constexpr SDL_Colour hitchColour = {0xE0, 0x30, 0x30, SDL_ALPHA_OPAQUE};
+constexpr SDL_Colour budgetLineColour = {0x80, 0x80, 0x80, SDL_ALPHA_OPAQUE};
+
+
+Millisecond toMilliseconds(Util::Second time) {
+    return Millisecond{time.value * 1000_r};
+}
+
+
+} // namespace
+
+
+PerformanceHud::PerformanceHud(FC_Font* font_) :
+    rFont{font_}
+{
+    assert(font_ && "PerformanceHud needs a font");
+}
+
+void PerformanceHud::handleToggleKey(std::span<const uint8_t> keyboard) {
+    // Only toggle when the key goes down, not every frame that it's held
+    const bool isKeyDown = keyboard[SDL_SCANCODE_F3] != 0;
+    if(isKeyDown && !mIsToggleKeyDown)
+        mIsVisible = !mIsVisible;
+    mIsToggleKeyDown = isKeyDown;
+}
+
+bool PerformanceHud::isVisible() const {
+    return mIsVisible;
+}
+
+void PerformanceHud::record(const FrameSample& sample) {
+    mLastSample = sample;
+    mFrameTimeHistory[mHistoryIndex] = sample.frameTime;
+    mHistoryIndex = (mHistoryIndex + 1) % historyLength;
+}
+
+void PerformanceHud::draw(Window& window) const {
+    if(!mIsVisible)
+        return;
+
+    // The text is formatted into a fixed buffer, so drawing the HUD doesn't allocate
+    const PixelLength lineHeight{static_cast<RenderReal>(FC_GetLineHeight(rFont) )};
+    PixelPosition lineLeftTop = hudLeftTop;
+    Util::FormatBuffer<lineCapacity> line;
+    const auto drawLine = [&](const Util::FormatBuffer<lineCapacity>& text) {
+        window.draw(rFont, lineLeftTop, text, DrawLayer::overlay);
+        lineLeftTop.y += lineHeight;
+    };
+    const auto tickTime = mLastSample.tickCount == 0 ?
+        0_s :
+        mLastSample.tickTime / static_cast<Util::Real>(mLastSample.tickCount);
+    drawLine(line.clear().append("frame: ").append(toMilliseconds(mLastSample.frameTime), timeFormat, " ms") );
+    drawLine(line.clear().append("tick: ").append(toMilliseconds(tickTime), timeFormat, " ms x")
+                 .appendNumber(mLastSample.tickCount) );
+    drawLine(line.clear().append("entities: ").appendNumber(mLastSample.entityCount) );
+    drawLine(line.clear().append("draw calls: ").appendNumber(mLastSample.renderStats.drawCallCount) );
+    drawLine(line.clear().append("vertices: ").appendNumber(mLastSample.renderStats.vertexCount) );
+    drawLine(line.clear().append("frame arena: ").appendNumber(mLastSample.frameArenaBytes / 1024).append(" KiB") );
+    if(Util::isAllocationTrackingEnabled() )
+        drawLine(line.clear().append("allocations: ").appendNumber(mLastSample.allocationCount) );
+
+    // The frame time graph, oldest on the left
+    const PixelPositionScalar graphBottom = lineLeftTop.y + graphHeight;
+    const auto barHeightPerSecond = graphHeight / static_cast<RenderSecond>(idealTickDuration * graphTickCount);
+    for(size_t i = 0; i < historyLength; ++i) {
+        const Util::Second frameTime = mFrameTimeHistory[(mHistoryIndex + i) % historyLength];
+        const PixelLength barHeight = min(static_cast<RenderSecond>(frameTime) * barHeightPerSecond, graphHeight);
+        const SDL_Colour barColour =
+            frameTime > idealTickDuration * 2_r ? hitchColour :
+            frameTime > idealTickDuration ? overBudgetColour :
+            onBudgetColour;
+        const PixelPositionScalar barLeft = hudLeftTop.x + barWidth * static_cast<RenderReal>(i);
+        window.draw(PixelRect::leftBottomSize({barLeft, graphBottom}, {barWidth, barHeight}), barColour, DrawLayer::overlay);
+    }
+    // A line at one tick, drawn after the bars so it's on top of them
+    const PixelLength budgetHeight = static_cast<RenderSecond>(idealTickDuration) * barHeightPerSecond;
+    const PixelLength graphWidth = barWidth * static_cast<RenderReal>(historyLength);
+    window.draw(
+        PixelRect::leftBottomSize({hudLeftTop.x, graphBottom - budgetHeight}, {graphWidth, 1_pl}),
+        budgetLineColour, DrawLayer::overlay
+    );
+}
+
+
+} // namespace Media
@@ -0,0 +1,65 @@
+
+#ifndef HPP_MEDIA_PERFORMANCEHUD_
+#define HPP_MEDIA_PERFORMANCEHUD_
+
+#include "window.hpp"
+
+#include "../util/dimension.hpp"
+
+#include <SDL_FontCache/SDL_FontCache.h>
+
+#include <array>
+#include <span>
+
+
+namespace Media
+{
+
+
+/**
+ * @brief What happened during a frame, as shown by the performance HUD
+ */
+struct FrameSample {
+    Util::Second frameTime;
+    Util::Second tickTime; // Total time spent on the ticks in the frame
+    unsigned tickCount;
+    size_t entityCount;
+    RenderStats renderStats;
+    uint64_t allocationCount; // Only counted when allocation tracking is enabled
+    size_t frameArenaBytes; // Used by the last frame
+};
+
+
+/**
+ * @brief A toggleable overlay with the frame timings and a graph of the recent frame times
+ * @note Drawn through the window's batches on the overlay layer, so it's only a couple of extra draw calls
+ */
+class PerformanceHud {
+public:
+    explicit PerformanceHud(FC_Font* font_);
+
+    /**
+     * @brief Toggle the HUD when the toggle key (F3) is pressed
+     * @param keyboard - the keyboard state from Media::keyboardState()
+     */
+    void handleToggleKey(std::span<const uint8_t> keyboard);
+    [[nodiscard]] bool isVisible() const;
+
+    void record(const FrameSample& sample);
+    void draw(Window& window) const;
+
+private:
+    constexpr static size_t historyLength = 128;
+
+    FC_Font* rFont{};
+    FrameSample mLastSample{};
+    std::array<Util::Second, historyLength> mFrameTimeHistory{};
+    size_t mHistoryIndex{};
+    bool mIsToggleKeyDown = false;
+    bool mIsVisible = false;
+};
+
+
+} // namespace Media
+
+#endif // ifndef HPP_MEDIA_PERFORMANCEHUD_
@@ -0,0 +1,239 @@
+
+#include "quad_vertices.hpp"
+
+#include "camera.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define MEDIA_QUAD_VERTICES_SSE2 1
+    #include <emmintrin.h>
+#endif // if SSE2 is available
+
+
+namespace Media
+{
+
+
+namespace
+{
+
+
+// The SIMD path writes the vertices as raw 32-bit words: {x, y, colour, u, v}
+static_assert(sizeof(SDL_Vertex) == 5 * sizeof(float) );
+static_assert(offsetof(SDL_Vertex, position) == 0);
+static_assert(offsetof(SDL_Vertex, color) == 2 * sizeof(float) );
+static_assert(offsetof(SDL_Vertex, tex_coord) == 3 * sizeof(float) );
+
+// Below this many quads, the vertices are likely to be still in the cache by the time they're rendered
+constexpr size_t streamingQuadCount = size_t{1} << 14;
+
+// The quads are made relative to the view origin in the simulation's precision, and only then rounded to float
+struct ScreenTransform {
+    Util::Real originX;
+    Util::Real originY;
+    float scaleX;
+    float scaleY;
+    float offsetX;
+    float offsetY;
+};
+
+void writeQuadVerticesScalar(const QuadArrays& quads, const ScreenTransform& transform, SDL_Colour colour,
+                             size_t first, SDL_Vertex* vertexIter)
+{
+    const size_t quadCount = quads.size();
+    for(size_t i = first; i < quadCount; ++i) {
+        const float vertexLeft = static_cast<float>(quads.rects.leftLst[i].value - transform.originX) * transform.scaleX
+                               + transform.offsetX;
+        const float vertexRight = static_cast<float>(quads.rects.rightLst[i].value - transform.originX) * transform.scaleX
+                                + transform.offsetX;
+        const float vertexTop = static_cast<float>(quads.rects.topLst[i].value - transform.originY) * transform.scaleY
+                              + transform.offsetY;
+        const float vertexBottom = static_cast<float>(quads.rects.bottomLst[i].value - transform.originY) * transform.scaleY
+                                 + transform.offsetY;
+        const float textureLeft = quads.textureLeftLst[i];
+        const float textureRight = quads.textureRightLst[i];
+        const float textureTop = quads.textureTopLst[i];
+        const float textureBottom = quads.textureBottomLst[i];
+        *vertexIter++ = SDL_Vertex{{vertexLeft, vertexTop}, colour, {textureLeft, textureTop} };
+        *vertexIter++ = SDL_Vertex{{vertexRight, vertexTop}, colour, {textureRight, textureTop} };
+        *vertexIter++ = SDL_Vertex{{vertexLeft, vertexBottom}, colour, {textureLeft, textureBottom} };
+        *vertexIter++ = SDL_Vertex{{vertexRight, vertexBottom}, colour, {textureRight, textureBottom} };
+    }
+}
+
+
+#ifdef MEDIA_QUAD_VERTICES_SSE2
+
+// 4 world coordinates relative to the origin, as floats
+template<typename T>
+__m128 loadViewCoords(const T* src, T origin) {
+    if constexpr(std::is_same_v<T, float>) {
+        return _mm_sub_ps(_mm_loadu_ps(src), _mm_set1_ps(origin) );
+    } else {
+        static_assert(std::is_same_v<T, double>);
+        const __m128d originPd = _mm_set1_pd(origin);
+        const __m128 low = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(src), originPd) );
+        const __m128 high = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(src + 2), originPd) );
+        return _mm_movelh_ps(low, high);
+    }
+}
+
+template<bool isStreaming, typename T>
+size_t writeQuadVerticesSse2(const QuadArrays& quads, const ScreenTransform& transform, SDL_Colour colour,
+                             SDL_Vertex* vertexLst)
+{
+    const size_t quadCount = quads.size();
+    const __m128 scaleX = _mm_set1_ps(transform.scaleX);
+    const __m128 scaleY = _mm_set1_ps(transform.scaleY);
+    const __m128 offsetX = _mm_set1_ps(transform.offsetX);
+    const __m128 offsetY = _mm_set1_ps(transform.offsetY);
+    const int c = std::bit_cast<int>(colour);
+
+    auto* outIter = reinterpret_cast<__m128i*>(vertexLst);
+    size_t i = 0;
+    for(; i + 4 <= quadCount; i += 4) {
+        // Transform 4 quads at once
+        alignas(16) int leftLst[4];
+        alignas(16) int topLst[4];
+        alignas(16) int rightLst[4];
+        alignas(16) int bottomLst[4];
+        const auto transformLane = [&](const T* src, T origin, __m128 scale, __m128 offset, int* dest) {
+            const __m128 screen = _mm_add_ps(_mm_mul_ps(loadViewCoords(src, origin), scale), offset);
+            _mm_store_si128(reinterpret_cast<__m128i*>(dest), _mm_castps_si128(screen) );
+        };
+        transformLane(&quads.rects.leftLst[i].value, transform.originX, scaleX, offsetX, leftLst);
+        transformLane(&quads.rects.topLst[i].value, transform.originY, scaleY, offsetY, topLst);
+        transformLane(&quads.rects.rightLst[i].value, transform.originX, scaleX, offsetX, rightLst);
+        transformLane(&quads.rects.bottomLst[i].value, transform.originY, scaleY, offsetY, bottomLst);
+
+        // Each quad is 4 vertices of 5 words, so it's written as 5 vectors
+        for(size_t lane = 0; lane < 4; ++lane) {
+            const int l = leftLst[lane];
+            const int t = topLst[lane];
+            const int r = rightLst[lane];
+            const int b = bottomLst[lane];
+            const int tl = std::bit_cast<int>(quads.textureLeftLst[i + lane]);
+            const int tt = std::bit_cast<int>(quads.textureTopLst[i + lane]);
+            const int tr = std::bit_cast<int>(quads.textureRightLst[i + lane]);
+            const int tb = std::bit_cast<int>(quads.textureBottomLst[i + lane]);
+            const __m128i quadWordLst[5] = {
+                _mm_setr_epi32(l, t, c, tl),
+                _mm_setr_epi32(tt, r, t, c),
+                _mm_setr_epi32(tr, tt, l, b),
+                _mm_setr_epi32(c, tl, tb, r),
+                _mm_setr_epi32(b, c, tr, tb),
+            };
+            for(const __m128i& quadWord : quadWordLst) {
+                if constexpr(isStreaming)
+                    _mm_stream_si128(outIter++, quadWord);
+                else
+                    _mm_storeu_si128(outIter++, quadWord);
+            }
+        }
+    }
+    if constexpr(isStreaming)
+        _mm_sfence();
+    return i;
+}
+
+#endif // ifdef MEDIA_QUAD_VERTICES_SSE2
+
+
+/**
+ * @brief Write the vertices of the quads with SIMD if it's available
+ * @return the number of quads that were written
+ * @note The tail is padded to a full SIMD register, so every quad is computed the same way
+ *       regardless of how the quads are split between calls
+ */
+template<typename T>
+size_t writeQuadVerticesSimd(const QuadArrays& quads, const ScreenTransform& transform, SDL_Colour colour,
+                             std::span<SDL_Vertex> vertexLst)
+{
+#ifdef MEDIA_QUAD_VERTICES_SSE2
+    if constexpr(std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        const size_t quadCount = quads.size();
+        // Non-temporal stores need 16-byte alignment, and every quad is 80 bytes so it stays aligned
+        const bool isAligned = reinterpret_cast<uintptr_t>(vertexLst.data() ) % 16 == 0;
+        const size_t first = (isAligned && quadCount >= streamingQuadCount) ?
+            writeQuadVerticesSse2<true, T>(quads, transform, colour, vertexLst.data() ) :
+            writeQuadVerticesSse2<false, T>(quads, transform, colour, vertexLst.data() );
+
+        const size_t tailCount = quadCount - first;
+        if(tailCount == 0)
+            return quadCount;
+        std::array<std::array<Util::BasePositionScalar, 4>, 4> paddedRectLst{};
+        std::array<std::array<float, 4>, 4> paddedTextureLst{};
+        const std::array<std::span<const Util::BasePositionScalar>, 4> rectSrcLst = {
+            quads.rects.leftLst, quads.rects.topLst, quads.rects.rightLst, quads.rects.bottomLst,
+        };
+        const std::array<std::span<const float>, 4> textureSrcLst = {
+            quads.textureLeftLst, quads.textureTopLst, quads.textureRightLst, quads.textureBottomLst,
+        };
+        for(size_t array = 0; array < rectSrcLst.size(); ++array) {
+            std::ranges::copy(rectSrcLst[array].subspan(first), paddedRectLst[array].begin() );
+            std::ranges::copy(textureSrcLst[array].subspan(first), paddedTextureLst[array].begin() );
+        }
+        const QuadArrays paddedQuads{
+            {paddedRectLst[0], paddedRectLst[1], paddedRectLst[2], paddedRectLst[3]},
+            paddedTextureLst[0], paddedTextureLst[1], paddedTextureLst[2], paddedTextureLst[3],
+        };
+        /*[[uninit]]*/ std::array<SDL_Vertex, 16> paddedVertexLst;
+        writeQuadVerticesSse2<false, T>(paddedQuads, transform, colour, paddedVertexLst.data() );
+        std::copy_n(paddedVertexLst.begin(), tailCount * 4, vertexLst.begin() + static_cast<ptrdiff_t>(first * 4) );
+        return quadCount;
+    }
+#endif // ifdef MEDIA_QUAD_VERTICES_SSE2
+    return 0;
+}
+
+
+} // namespace
+
+
+size_t QuadArrays::size() const {
+    const size_t quadCount = rects.size();
+    assert(textureLeftLst.size() == quadCount && textureTopLst.size() == quadCount &&
+           textureRightLst.size() == quadCount && textureBottomLst.size() == quadCount &&
+           "All the arrays must be the same size");
+    return quadCount;
+}
+
+QuadArrays QuadArrays::subspan(size_t offset, size_t count) const {
+    return {
+        rects.subspan(offset, count),
+        textureLeftLst.subspan(offset, count),
+        textureTopLst.subspan(offset, count),
+        textureRightLst.subspan(offset, count),
+        textureBottomLst.subspan(offset, count),
+    };
+}
+
+void writeQuadVertices(const QuadArrays& quads, const Camera& camera, SDL_Colour colour,
+                       std::span<SDL_Vertex> vertexLst)
+{
+    assert(vertexLst.size() >= quads.size() * 4 && "Not enough room for the vertices");
+    const auto viewOrigin = camera.getViewOrigin();
+    const auto screenScale = camera.getScreenScale();
+    const auto screenOffset = camera.getScreenOffset();
+    const ScreenTransform transform{
+        viewOrigin.x.value,
+        viewOrigin.y.value,
+        screenScale.x.value,
+        screenScale.y.value,
+        screenOffset.x.value,
+        screenOffset.y.value,
+    };
+
+    // Without SIMD, the quads are written one at a time
+    const size_t first = writeQuadVerticesSimd<Util::Real>(quads, transform, colour, vertexLst);
+    writeQuadVerticesScalar(quads, transform, colour, first, vertexLst.data() + first * 4);
+}
+
+
+} // namespace Media
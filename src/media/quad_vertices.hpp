@@ -0,0 +1,47 @@
+
+#ifndef HPP_MEDIA_QUADVERTICES_
+#define HPP_MEDIA_QUADVERTICES_
+
+#include "../util/rect_arrays.hpp"
+#include "../util/typedefs.hpp"
+
+#include <SDL2/SDL_render.h>
+
+#include <span>
+
+
+namespace Media
+{
+
+
+class Camera;
+
+/**
+ * @brief Many quads stored as a structure-of-arrays, so that their vertices can be generated at once
+ * @note Every span must have the same size
+ */
+struct QuadArrays {
+    // The quads' rects in world space
+    Util::BaseRectSpans rects;
+    // The quads' rects in the texture (normalised texture coordinates)
+    std::span<const float> textureLeftLst;
+    std::span<const float> textureTopLst;
+    std::span<const float> textureRightLst;
+    std::span<const float> textureBottomLst;
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] QuadArrays subspan(size_t offset, size_t count) const;
+};
+
+/**
+ * @brief Generate the screen space vertices for every quad, with the same layout as Sprite::getVertices
+ * @param vertexLst - where the vertices are written, must have room for 4 vertices per quad
+ * @note Uses SSE2 when available, and non-temporal stores for large aligned outputs
+ */
+void writeQuadVertices(const QuadArrays& quads, const Camera& camera, SDL_Colour colour,
+                       std::span<SDL_Vertex> vertexLst);
+
+
+} // namespace Media
+
+#endif // ifndef HPP_MEDIA_QUADVERTICES_
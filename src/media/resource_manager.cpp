@@ -1,13 +1,16 @@
 
 #include "resource_manager.hpp"
 
+#include "../util/finally.hpp"
 #include "../util/get_dir.hpp"
+#include "../util/memory_report.hpp"
+#include "../util/profiler.hpp"
 
 #include <SDL_FontCache/SDL_FontCache.h>
 
 #include <SDL2/SDL_image.h>
 
-#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 #include <typeinfo>
 
@@ -28,31 +31,34 @@ namespace
 {
 
 
-template<typename C, typename L> inline
-auto find_if(const C& container, const L& lambda) {
-    return std::find_if(container.begin(), container.end(), lambda);
+template<typename Map> inline
+auto findResource(const Map& resourceMap, std::string_view key) {
+    const auto iter = resourceMap.find(key);
+    if(iter == resourceMap.end() )
+        throw runtime_error("Cannot find resource with key:" + string(key) + " of type:" + typeid(typename Map::mapped_type).name() );
+    return iter->second.get();
 }
 
-
-template<typename Data> inline
-auto findResource(const std::vector<Data>& resourceLst, std::string_view key) {
-    const auto iter = find_if(resourceLst, [key](const Data& elem){return elem.key == key;});
-    if(iter == cend(resourceLst) )
-        throw runtime_error("Cannot find resource with key:" + string(key) + " of type:" + typeid(Data).name() );
-    return iter->data.get();
-}
-
-template<typename Data> inline
-void ensureResourceKeyDoesntExist(const std::vector<Data>& resourceLst, std::string_view key) {
-    const auto iter = find_if(resourceLst, [key](const Data& elem){return elem.key == key;});
-    if(iter != cend(resourceLst) ) {
-        const string typeName = typeid(Data).name();
+template<typename Map> inline
+void ensureResourceKeyDoesntExist(const Map& resourceMap, std::string_view key) {
+    if(resourceMap.contains(key) ) {
+        const string typeName = typeid(typename Map::mapped_type).name();
         const string keyName = string(key);
         throw runtime_error("Resource with key:" + keyName + " and type:" + typeName + "already exists");
     }
 }
 
 
+uint64_t getTextureBytes(SDL_Texture* texture) {
+    /*[[uninit]]*/ Uint32 format;
+    /*[[uninit]]*/ int w;
+    /*[[uninit]]*/ int h;
+    if(SDL_QueryTexture(texture, &format, nullptr, &w, &h) != 0)
+        return 0;
+    return static_cast<uint64_t>(w) * static_cast<uint64_t>(h) * SDL_BYTESPERPIXEL(format);
+}
+
+
 } // namespace
 
 
@@ -60,12 +66,22 @@ ResourceManager::ResourceManager(SDL_Renderer* renderer_) :
     rRenderer{renderer_}
 {}
 
+auto ResourceManager::countLoad() {
+    using std::chrono::steady_clock;
+    return Util::Finally{[this, startTime = steady_clock::now()]() noexcept {
+        ++mLoadStats.loadCount;
+        mLoadStats.loadTime += Util::fromChrono<Util::Real, Util::BaseRatio>(steady_clock::now() - startTime);
+    }};
+}
+
 SDL_Texture* ResourceManager::getTexture(std::string_view key) const {
-    return findResource(mTextureLst, key);
+    return findResource(mTextureMap, key);
 }
 
 void ResourceManager::loadTexture(const std::filesystem::path& relativePath, std::string_view key) {
-    ensureResourceKeyDoesntExist(mTextureLst, key);
+    UTIL_PROFILE_ZONE("loadTexture");
+    const auto loadGuard = countLoad();
+    ensureResourceKeyDoesntExist(mTextureMap, key);
 
     const auto absolutePath = Util::getResDir() / relativePath;
 
@@ -76,51 +92,53 @@ void ResourceManager::loadTexture(const std::filesystem::path& relativePath, std
     if(!surface)
         throw std::runtime_error("Can't load image: "s + C_STR(absolutePath) + "\n" + SDL_GetError() );
 
-    std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> texture{
+    TexturePtr texture{
         SDL_CreateTextureFromSurface(rRenderer, surface.get() ),
         &SDL_DestroyTexture,
     };
     if(!texture)
         throw std::runtime_error("Texture is invalid\n"s + SDL_GetError() );
 
-    // mTextureLst.emplace_back(std::string(key), std::move(texture) ); //clang cannot compile this
-    mTextureLst.push_back(TextureData{std::string(key), std::move(texture)});
+    mTextureMap.try_emplace(std::string(key), std::move(texture) );
 }
 
 void ResourceManager::clearTextures() {
-    mTextureLst.clear();
+    mTextureMap.clear();
 }
 
 Mix_Chunk* ResourceManager::getSoundEffect(std::string_view key) const {
-    return findResource(mSoundEffectLst, key);
+    return findResource(mSoundEffectMap, key);
 }
 
 void ResourceManager::loadSoundEffect(const std::filesystem::path& relativePath, std::string_view key)
 {
-    ensureResourceKeyDoesntExist(mSoundEffectLst, key);
+    UTIL_PROFILE_ZONE("loadSoundEffect");
+    const auto loadGuard = countLoad();
+    ensureResourceKeyDoesntExist(mSoundEffectMap, key);
 
     const std::filesystem::path absolutePath = Util::getResDir() / relativePath;
 
-    std::unique_ptr<Mix_Chunk, decltype(&Mix_FreeChunk)> sfx{
+    SoundEffectPtr sfx{
         Mix_LoadWAV(C_STR(absolutePath) ),
         &Mix_FreeChunk,
     };
     if(!sfx)
         throw std::runtime_error("Can't load sfx: "s + C_STR(absolutePath) + "\n" + Mix_GetError() );
 
-    // mSoundEffectLst.emplace_back(string(key), std::move(sfx) ); //clang cannot compile this
-    mSoundEffectLst.push_back(SoundEffectData{string(key), std::move(sfx)});
+    mSoundEffectMap.try_emplace(string(key), std::move(sfx) );
 }
 
 void ResourceManager::clearSoundEffects() {
-    mSoundEffectLst.clear();
+    mSoundEffectMap.clear();
 }
 
 FC_Font* ResourceManager::getFont(std::string_view key) const {
-    return findResource(mFontLst, key);
+    return findResource(mFontMap, key);
 }
 
 void ResourceManager::loadFont(const std::filesystem::path& relativePath, std::string_view key) {
+    UTIL_PROFILE_ZONE("loadFont");
+    const auto loadGuard = countLoad();
     const auto absolutePath = Util::getResDir() / relativePath;
     std::unique_ptr<FC_Font, decltype(&FC_FreeFont)> font{FC_CreateFont(), &FC_FreeFont};
     // TODO: Add check for null (no point now since FC_CreateFont is broken if malloc returns null)
@@ -134,12 +152,29 @@ void ResourceManager::loadFont(const std::filesystem::path& relativePath, std::s
     if( !FC_LoadFont(font.get(), rRenderer, C_STR(absolutePath), fontSize, fontColour, fontStyle) )
         throw std::runtime_error("Can't load font: "s + C_STR(absolutePath) + "\n" + TTF_GetError() );
 
-    // mFontLst.emplace_back(string(key), std::move(font) ); //clang cannot compile this
-    mFontLst.push_back(FontData{string(key), std::move(font)});
+    mFontMap.try_emplace(string(key), std::move(font) );
 }
 
 void ResourceManager::clearFonts() {
-    mFontLst.clear();
+    mFontMap.clear();
+}
+
+LoadStats ResourceManager::loadStats() const {
+    return mLoadStats;
+}
+
+void ResourceManager::reportMemory(Util::MemoryReport& report) const {
+    for(const auto& [key, texture] : mTextureMap)
+        report.add("textures", key, getTextureBytes(texture.get() ) );
+    for(const auto& [key, soundEffect] : mSoundEffectMap)
+        report.add("sound effects", key, soundEffect->alen);
+    for(const auto& [key, font] : mFontMap) {
+        uint64_t cacheBytes = 0;
+        const int cacheLevelCount = FC_GetNumCacheLevels(font.get() );
+        for(int level=0; level<cacheLevelCount; ++level)
+            cacheBytes += getTextureBytes(FC_GetGlyphCacheLevel(font.get(), level) );
+        report.add("font glyphs", key, cacheBytes);
+    }
 }
 
 
@@ -2,6 +2,9 @@
 #ifndef HPP_MEDIA_RESOURCEMANAGER_3311664024594_
 #define HPP_MEDIA_RESOURCEMANAGER_3311664024594_
 
+#include "../util/dimension.hpp"
+#include "../util/flat_map.hpp"
+
 #include <SDL2/SDL_mixer.h>
 #include <SDL2/SDL_render.h>
 
@@ -9,10 +12,14 @@
 #include <memory>
 #include <string>
 #include <string_view>
-#include <vector>
 
 struct FC_Font;
 
+namespace Util
+{
+class MemoryReport;
+} // namespace Util
+
 
 namespace Media
 {
@@ -21,6 +28,15 @@ namespace Media
 namespace fs = std::filesystem;
 
 
+/**
+ * @brief Totals of the loads attempted by a resource manager, including failed ones
+ */
+struct LoadStats {
+    uint64_t loadCount;
+    Util::Second loadTime;
+};
+
+
 class ResourceManager {
 public:
     explicit ResourceManager(SDL_Renderer* renderer_);
@@ -37,25 +53,32 @@ public:
     void loadFont(const std::filesystem::path& relativePath, std::string_view key);
     void clearFonts();
 
+    [[nodiscard]] LoadStats loadStats() const;
+    /**
+     * @brief Add the bytes of every texture, sound effect and font glyph cache
+     * @note Textures are counted as width x height x bytes per pixel, so it's an estimate of the GPU memory
+     */
+    void reportMemory(Util::MemoryReport& report) const;
+
 private:
-    struct TextureData {
-        std::string key;
-        std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> data;
-    };
-    struct SoundEffectData {
-        std::string key;
-        std::unique_ptr<Mix_Chunk, decltype(&Mix_FreeChunk)> data;
-    };
-    struct FontData {
-        std::string key;
-        std::unique_ptr<FC_Font, void(*)(FC_Font*)> data;
-    };
-
-
-    std::vector<TextureData> mTextureLst{};
-    std::vector<SoundEffectData> mSoundEffectLst{};
-    std::vector<FontData> mFontLst{};
+    using TexturePtr = std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>;
+    using SoundEffectPtr = std::unique_ptr<Mix_Chunk, decltype(&Mix_FreeChunk)>;
+    using FontPtr = std::unique_ptr<FC_Font, void(*)(FC_Font*)>;
+
+    // The game loads a handful of each, so they're kept inline and sorted by key for lookups
+    static constexpr size_t inlineResourceCount = 8;
+    template<typename Ptr>
+    using ResourceMap = Util::SmallFlatMap<std::string, Ptr, inlineResourceCount>;
+
+    // Adds to mLoadStats when the returned guard goes out of scope
+    [[nodiscard]] auto countLoad();
+
+
+    ResourceMap<TexturePtr> mTextureMap{};
+    ResourceMap<SoundEffectPtr> mSoundEffectMap{};
+    ResourceMap<FontPtr> mFontMap{};
     SDL_Renderer* rRenderer{};
+    LoadStats mLoadStats{};
 };
 
 
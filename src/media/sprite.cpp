@@ -4,7 +4,6 @@
 #include "camera.hpp"
 
 #include <cassert>
-#include <utility>
 
 
 namespace Media
@@ -31,14 +30,15 @@ PixelDisplacement getTextureSize(SDL_Texture* texture) {
 
 using namespace Util;
 
-Sprite::Sprite(SDL_Texture* texture_, std::vector<Animation> animationLst_) :
+Sprite::Sprite(SDL_Texture* texture_, std::span<const Animation> animationLst_) :
     rTexture{texture_},
-    mAnimationLst{std::move(animationLst_)},
+    mAnimationLst{animationLst_},
     mAnimationIndex{0},
     mFrameIndex{0},
     mElasped{0_s}
 {
     assert(texture_ && "Sprite cannot take a null texture");
+    assert(!animationLst_.empty() && "Sprite needs an animation");
 }
 
 std::array<SDL_Vertex, 4> Sprite::getVertices(const BaseRect& posRect, const Camera& camera) const
@@ -48,14 +48,17 @@ std::array<SDL_Vertex, 4> Sprite::getVertices(const BaseRect& posRect, const Cam
     const PixelRect frameRect = getRect();
 
     // Get the tex-coordinates
-    const Real textureLeft = frameRect.left() / textureSize.x;
-    const Real textureRight = frameRect.right() / textureSize.x;
-    const Real textureTop = frameRect.top() / textureSize.y;
-    const Real textureBottom = frameRect.bottom() / textureSize.y;
+    const float textureLeft = frameRect.left() / textureSize.x;
+    const float textureRight = frameRect.right() / textureSize.x;
+    const float textureTop = frameRect.top() / textureSize.y;
+    const float textureBottom = frameRect.bottom() / textureSize.y;
 
     // Get the vertex-cooridantes
-    const auto [vertexLeft, vertexTop] = camera.toScreenCoord(posRect.leftTop() );
-    const auto [vertexRight, vertexBottom] = camera.toScreenCoord(posRect.rightBottom() );
+    const std::array<BasePosition, 2> cornerLst = {posRect.leftTop(), posRect.rightBottom()};
+    /*[[uninit]]*/ std::array<PixelPosition, 2> screenCornerLst;
+    camera.toScreenCoords(cornerLst, screenCornerLst);
+    const auto [vertexLeft, vertexTop] = screenCornerLst[0];
+    const auto [vertexRight, vertexBottom] = screenCornerLst[1];
 
     return {
         SDL_Vertex{
@@ -109,12 +112,12 @@ void Sprite::switchMode(std::string_view mode, bool resetFrame) {
 }
 
 void Sprite::update(Util::Second dt) {
-    auto& animation = mAnimationLst[mAnimationIndex];
+    const auto& animation = mAnimationLst[mAnimationIndex];
     const auto totalFrameTime = animation.frameLst[mFrameIndex].time;
     if(mElasped >= totalFrameTime) { // assumes that mElasped < 2*totalFrameTime
         mElasped -= totalFrameTime;
         ++mFrameIndex;
-        if(mFrameIndex >= size(animation.frameLst) )
+        if(mFrameIndex >= animation.frameLst.size() )
             mFrameIndex = 0;
     }
     mElasped += dt;
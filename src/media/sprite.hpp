@@ -6,12 +6,12 @@
 
 #include "../util/macros.hpp"
 #include "../util/rect.hpp"
+#include "../util/static_vector.hpp"
 
 #include <array>
 #include <limits>
-#include <string>
+#include <span>
 #include <string_view>
-#include <vector>
 
 #include <SDL2/SDL_render.h>
 
@@ -22,26 +22,32 @@ namespace Media
 
 class Camera;
 
-constexpr Util::Second forever{std::numeric_limits<Util::Real>::infinity()};
+// Fixed-point types have no infinity, so they use the longest time instead
+constexpr Util::Second forever{std::numeric_limits<Util::Real>::has_infinity ? std::numeric_limits<Util::Real>::infinity()
+                                                                             : std::numeric_limits<Util::Real>::max()};
+
+// Enough for any animation the game has, frames are stored inline so animation tables can be constexpr
+constexpr size_t maxAnimationFrameCount = 8;
 
 struct AnimationFrame {
-    PixelRect rect;
-    Util::Second time;
+    PixelRect rect = PixelRect::zero();
+    Util::Second time{};
 };
 
 struct Animation {
-    std::string modeName;
-    std::vector<AnimationFrame> frameLst;
+    std::string_view modeName;
+    Util::StaticVector<AnimationFrame, maxAnimationFrameCount> frameLst;
 };
 
 /**
  * @brief An animated sprite
- * @todo maybe use the flyweight pattern to reduce memory usage
+ * @note The animations are shared (flyweight), so they must outlive the sprite,
+ *       which makes copying a sprite allocation free
  */
 class Sprite
 {
 public:
-    /*[[implicit]]*/ Sprite(SDL_Texture* texture_, std::vector<Animation> animationLst_);
+    /*[[implicit]]*/ Sprite(SDL_Texture* texture_, std::span<const Animation> animationLst_);
 
     [[nodiscard]] std::array<SDL_Vertex, 4> getVertices(const Util::BaseRect& posRect, const Camera& camera) const;
     [[nodiscard]] SDL_Texture* getTexture() const;
@@ -52,7 +58,7 @@ public:
 
 private:
     SDL_Texture* rTexture{};
-    std::vector<Animation> mAnimationLst{};
+    std::span<const Animation> mAnimationLst{};
     size_t mAnimationIndex{};
     size_t mFrameIndex{};
     Util::Second mElasped{};
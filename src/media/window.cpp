@@ -4,9 +4,19 @@
 #include "drawable.hpp"
 #include "sprite.hpp"
 
+#include "../util/frame_arena.hpp"
+#include "../util/memory_report.hpp"
+#include "../util/profiler.hpp"
+#include "../util/radix_sort.hpp"
+#include "../util/rect_arrays.hpp"
+#include "../util/worker_pool.hpp"
+
 #include <SDL2/SDL_keyboard.h>
 #include <SDL2/SDL_mouse.h>
 
+#include <algorithm>
+#include <cassert>
+#include <numeric>
 #include <string>
 
 
@@ -21,14 +31,58 @@ namespace
 {
 
 
+// The draw key is packed as [unused:8][layer:8][texture:16][sequence:32]
+constexpr unsigned sequenceBits = 32;
+constexpr unsigned textureBits = 16;
+constexpr uint64_t sequenceMask = (uint64_t{1} << sequenceBits) - 1;
+constexpr uint64_t textureMask = (uint64_t{1} << textureBits) - 1;
+
+// Below this many quads per thread, it's not worth waking up the workers
+constexpr size_t minQuadsPerChunk = 4096;
+
+constexpr uint64_t packDrawKey(DrawLayer layer, uint64_t textureIndex, uint64_t sequence) {
+    return (static_cast<uint64_t>(layer) << (sequenceBits + textureBits) ) |
+           (textureIndex << sequenceBits) |
+           sequence;
+}
+
+
 PixelDisplacement getWindowSize(SDL_Window* window) {
-    using Util::Real;
     /*[[uninit]]*/ int w;
     /*[[uninit]]*/ int h;
     SDL_GetWindowSize(window, &w, &h);
     return {
-        PixelDistance{static_cast<Real>(w)},
-        PixelDistance{static_cast<Real>(h)},
+        PixelDistance{static_cast<RenderReal>(w)},
+        PixelDistance{static_cast<RenderReal>(h)},
+    };
+}
+
+/**
+ * @brief Creates the vertices of a quad in screen space
+ * @param dest - the quad's screen rect in pixels
+ * @param src - the quad's rect in the texture in pixels
+ * @param textureSize - the size of the texture in pixels
+ */
+std::array<SDL_Vertex, 4> makeQuad(const SDL_FRect& dest, const SDL_Rect& src, SDL_Point textureSize,
+                                   SDL_Colour colour)
+{
+    const float textureWidth = static_cast<float>(textureSize.x);
+    const float textureHeight = static_cast<float>(textureSize.y);
+    const float textureLeft = static_cast<float>(src.x) / textureWidth;
+    const float textureRight = static_cast<float>(src.x + src.w) / textureWidth;
+    const float textureTop = static_cast<float>(src.y) / textureHeight;
+    const float textureBottom = static_cast<float>(src.y + src.h) / textureHeight;
+    const float vertexLeft = dest.x;
+    const float vertexRight = dest.x + dest.w;
+    const float vertexTop = dest.y;
+    const float vertexBottom = dest.y + dest.h;
+
+    // Same vertex order as Sprite::getVertices
+    return {
+        SDL_Vertex{{vertexLeft, vertexTop}, colour, {textureLeft, textureTop} },
+        SDL_Vertex{{vertexRight, vertexTop}, colour, {textureRight, textureTop} },
+        SDL_Vertex{{vertexLeft, vertexBottom}, colour, {textureLeft, textureBottom} },
+        SDL_Vertex{{vertexRight, vertexBottom}, colour, {textureRight, textureBottom} },
     };
 }
 
@@ -79,6 +133,10 @@ PixelDisplacement Window::currentSize() const {
     };
 }
 
+RenderStats Window::lastRenderStats() const {
+    return mLastRenderStats;
+}
+
 Util::BasePosition Window::mouseWorldCoord() const {
     int x; /*[[uninit]]*/
     /*[[uninit]]*/ int y;
@@ -92,6 +150,24 @@ Util::BasePosition Window::mouseWorldCoord() const {
     return mCamera.toWorldCoord(mouseLogicalScreenPos);
 }
 
+void Window::reserveQuads(size_t quadCount) {
+    mVertexLst.reserve(quadCount * 4);
+    mDrawKeyLst.reserve(quadCount);
+    mSpriteRectLst.reserve(quadCount);
+    mSpriteTextureLeftLst.reserve(quadCount);
+    mSpriteTextureTopLst.reserve(quadCount);
+    mSpriteTextureRightLst.reserve(quadCount);
+    mSpriteTextureBottomLst.reserve(quadCount);
+}
+
+void Window::reportMemory(Util::MemoryReport& report) const {
+    report.add("window", "vertices", mVertexLst.capacity() * sizeof(SDL_Vertex) );
+    report.add("window", "draw keys", mDrawKeyLst.capacity() * sizeof(uint64_t) );
+    report.add("window", "textures", mTextureLst.capacity() * sizeof(SDL_Texture*) );
+    report.add("window", "sprites", mSpriteRectLst.capacity() * sizeof(Util::BasePositionScalar) * 4 +
+                                    mSpriteTextureLeftLst.capacity() * sizeof(float) * 4);
+}
+
 void Window::clear() {
     SDL_SetRenderDrawColor(mRenderer.get(), 0x00, 0x00, 0x00, SDL_ALPHA_OPAQUE);
     SDL_RenderClear(mRenderer.get() );
@@ -101,60 +177,233 @@ void Window::draw(const Drawable& drawable) {
     drawable.draw(*this);
 }
 
-void Window::draw(const Sprite& sprite, const Util::BaseRect& posRect) {
-    // Obtain the batch corresponding to the sprite's texture
-    SDL_Texture* texture = sprite.getTexture();
-    TextureBatch& batch = [texture, this]() -> TextureBatch& {
-        for(auto& batchElem : mBatchLst) {
-            if(batchElem.texture == texture)
-                return batchElem;
+void Window::draw(const Sprite& sprite, const Util::BaseRect& posRect, DrawLayer layer) {
+    addQuad(sprite.getTexture(), layer, sprite.getVertices(posRect, mCamera) );
+}
+
+void Window::draw(SDL_Texture* texture, const QuadArrays& quads, DrawLayer layer) {
+    UTIL_PROFILE_ZONE("drawQuads");
+    // The quads are split into chunks for the worker threads, small submissions just use one chunk
+    auto& workerPool = Util::defaultWorkerPool();
+    const size_t quadCount = quads.size();
+    const size_t chunkCount = std::clamp<size_t>(quadCount / minQuadsPerChunk, 1, workerPool.threadCount() + 1);
+    const size_t chunkSize = (quadCount + chunkCount - 1) / chunkCount;
+    const auto chunkRange = [quadCount, chunkSize](size_t chunk) {
+        return std::pair{std::min(chunk * chunkSize, quadCount), std::min( (chunk + 1) * chunkSize, quadCount)};
+    };
+
+    // Cull the quads outside of the view, and count the visible quads in each chunk
+    const Util::BaseRect viewRect = mCamera.getViewBound();
+    auto& frameArena = Util::defaultFrameArenas().current();
+    Util::ScratchVector<uint8_t> quadVisibilityLst(quadCount, &frameArena);
+    Util::ScratchVector<size_t> chunkOffsetLst(chunkCount + 1, 0, &frameArena);
+    workerPool.parallelFor(chunkCount, [&](size_t chunk) {
+        UTIL_PROFILE_ZONE("cullQuads");
+        const auto [begin, end] = chunkRange(chunk);
+        chunkOffsetLst[chunk + 1] = Util::collisionMask(viewRect, quads.rects.subspan(begin, end - begin),
+                                                        std::span{quadVisibilityLst}.subspan(begin, end - begin) );
+    });
+
+    // The prefix sum gives each chunk its own contiguous region of the buffers
+    std::partial_sum(chunkOffsetLst.begin(), chunkOffsetLst.end(), chunkOffsetLst.begin() );
+    const size_t visibleCount = chunkOffsetLst.back();
+    const size_t sequenceZero = mDrawKeyLst.size();
+    assert(sequenceZero + visibleCount <= sequenceMask && "Too many quads drawn in one frame");
+    mVertexLst.resize( (sequenceZero + visibleCount) * 4);
+    mDrawKeyLst.resize(sequenceZero + visibleCount);
+    const uint64_t textureIndex = getTextureIndex(texture);
+
+    // Each run of visible quads has its vertices written at once
+    workerPool.parallelFor(chunkCount, [&](size_t chunk) {
+        UTIL_PROFILE_ZONE("writeQuadVertices");
+        const auto [begin, end] = chunkRange(chunk);
+        size_t sequence = sequenceZero + chunkOffsetLst[chunk];
+        for(size_t runBegin = begin; runBegin < end; ) {
+            if(!quadVisibilityLst[runBegin]) {
+                ++runBegin;
+                continue;
+            }
+            size_t runEnd = runBegin + 1;
+            while(runEnd < end && quadVisibilityLst[runEnd])
+                ++runEnd;
+            const size_t runCount = runEnd - runBegin;
+            writeQuadVertices(
+                quads.subspan(runBegin, runCount), mCamera, {0xFF, 0xFF, 0xFF, SDL_ALPHA_OPAQUE},
+                std::span{mVertexLst}.subspan(sequence * 4, runCount * 4)
+            );
+            for(size_t i = 0; i < runCount; ++i, ++sequence)
+                mDrawKeyLst[sequence] = packDrawKey(layer, textureIndex, sequence);
+            runBegin = runEnd;
         }
-        mBatchLst.push_back(TextureBatch{texture, {}, {} });
-        return mBatchLst.back();
-    }();
-
-    // Add the sprite's vertices to the batch
-    auto& vertexLst = batch.vertexLst;
-    auto& indexLst = batch.indexLst;
-    const int indexZero = static_cast<int>(vertexLst.size() );
-    for(const auto vertex : sprite.getVertices(posRect, mCamera) )
-        vertexLst.push_back(vertex);
-    // Two triangles so vertex (0,1,2) and (3,1,2)
-    for(int offset : {0, 1, 2, 3, 1, 2})
-        indexLst.push_back(indexZero + offset);
-}
-
-void Window::draw(const PixelRect& rect, SDL_Color colour) {
-    const SDL_FRect drawRect{
+    });
+}
+
+void Window::beginSprites(size_t maxCount, DrawLayer layer) {
+    // Only grows, so after reserveQuads drawing the same number of sprites doesn't allocate
+    if(mSpriteRectLst.size() < maxCount) {
+        mSpriteRectLst.resize(maxCount);
+        mSpriteTextureLeftLst.resize(maxCount);
+        mSpriteTextureTopLst.resize(maxCount);
+        mSpriteTextureRightLst.resize(maxCount);
+        mSpriteTextureBottomLst.resize(maxCount);
+    }
+    mSpriteCount = 0;
+    mSpriteRunBegin = 0;
+    rSpriteRunTexture = nullptr;
+    mSpriteLayer = layer;
+}
+
+void Window::endSprites() {
+    drawSpriteRun(rSpriteRunTexture, mSpriteRunBegin, mSpriteCount, mSpriteLayer);
+    mSpriteCount = 0;
+    mSpriteRunBegin = 0;
+    rSpriteRunTexture = nullptr;
+}
+
+void Window::drawSpriteRun(SDL_Texture* texture, size_t begin, size_t end, DrawLayer layer) {
+    if(begin == end)
+        return;
+    const size_t count = end - begin;
+
+    // The texture is queried once for the whole run, to normalise the texture rects
+    /*[[uninit]]*/ int textureWidth;
+    /*[[uninit]]*/ int textureHeight;
+    SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+    const float inverseWidth = 1.0f / static_cast<float>(textureWidth);
+    const float inverseHeight = 1.0f / static_cast<float>(textureHeight);
+    for(size_t i=begin; i<end; ++i) {
+        mSpriteTextureLeftLst[i] *= inverseWidth;
+        mSpriteTextureTopLst[i] *= inverseHeight;
+        mSpriteTextureRightLst[i] *= inverseWidth;
+        mSpriteTextureBottomLst[i] *= inverseHeight;
+    }
+
+    const QuadArrays quads{
+        mSpriteRectLst.spans().subspan(begin, count),
+        std::span<const float>{mSpriteTextureLeftLst}.subspan(begin, count),
+        std::span<const float>{mSpriteTextureTopLst}.subspan(begin, count),
+        std::span<const float>{mSpriteTextureRightLst}.subspan(begin, count),
+        std::span<const float>{mSpriteTextureBottomLst}.subspan(begin, count),
+    };
+    draw(texture, quads, layer);
+}
+
+void Window::draw(const PixelRect& rect, SDL_Color colour, DrawLayer layer) {
+    // An untextured quad, so that it's ordered by its layer like everything else
+    const SDL_FRect dest{
         rect.left().value,
         rect.top().value,
         rect.width().value,
         rect.height().value,
     };
-    SDL_SetRenderDrawColor(mRenderer.get(), colour.r, colour.g, colour.b, colour.a);
-    SDL_RenderFillRectF(mRenderer.get(), &drawRect);
+    addQuad(nullptr, layer, makeQuad(dest, {0, 0, 1, 1}, {1, 1}, colour) );
 }
 
-void Window::draw(FC_Font* font, PixelPosition leftTop, Util::CStringView text)
+void Window::draw(FC_Font* font, PixelPosition leftTop, Util::CStringView text, DrawLayer layer)
 {
+    // The text is laid out as quads from the font's glyph atlas, so that it's batched like the sprites
+    const SDL_Colour colour = FC_GetDefaultColor(font);
+    const float lineHeight = static_cast<float>(FC_GetLineHeight(font) + FC_GetLineSpacing(font) );
+    const float letterSpacing = static_cast<float>(FC_GetSpacing(font) );
     const auto [left, top] = leftTop;
-    FC_Draw(font, mRenderer.get(), left.value, top.value, text.data() );
+    float glyphLeft = left.value;
+    float glyphTop = top.value;
+
+    SDL_Texture* atlas = nullptr;
+    SDL_Point atlasSize{};
+    const char* textIter = text.c_str();
+    while(*textIter != '\0') {
+        Uint32 codepoint = FC_GetCodepointFromUTF8(&textIter, 1);
+        if(codepoint == '\n') {
+            glyphLeft = left.value;
+            glyphTop += lineHeight;
+            continue;
+        }
+
+        /*[[uninit]]*/ FC_GlyphData glyph;
+        // Like FC_Draw, glyphs that are not cached are drawn as spaces
+        if(!FC_GetGlyphData(font, &glyph, codepoint) ) {
+            codepoint = ' ';
+            if(!FC_GetGlyphData(font, &glyph, codepoint) )
+                continue;
+        }
+
+        if(codepoint != ' ') {
+            SDL_Texture* glyphAtlas = FC_GetGlyphCacheLevel(font, glyph.cache_level);
+            if(glyphAtlas != atlas) {
+                atlas = glyphAtlas;
+                SDL_QueryTexture(atlas, nullptr, nullptr, &atlasSize.x, &atlasSize.y);
+            }
+            const SDL_FRect dest{
+                glyphLeft,
+                glyphTop,
+                static_cast<float>(glyph.rect.w),
+                static_cast<float>(glyph.rect.h),
+            };
+            addQuad(atlas, layer, makeQuad(dest, glyph.rect, atlasSize, colour) );
+        }
+        glyphLeft += static_cast<float>(glyph.rect.w) + letterSpacing;
+    }
 }
 
 void Window::display() {
-    // Render all the batches
-    for(const auto& batch : mBatchLst) {
+    UTIL_PROFILE_ZONE("display");
+    // Stable sort by (layer, texture), the keys are already in sequence order so those bytes are skipped
+    const size_t quadCount = mDrawKeyLst.size();
+    auto& frameArena = Util::defaultFrameArenas().current();
+    Util::ScratchVector<uint64_t> sortScratch(quadCount, &frameArena);
+    Util::radixSort(mDrawKeyLst, sortScratch, sequenceBits / 8);
+
+    // Two triangles for each quad so vertex (0,1,2) and (3,1,2)
+    Util::ScratchVector<int> indexLst(quadCount * 6, &frameArena);
+    auto indexIter = indexLst.begin();
+    for(const uint64_t key : mDrawKeyLst) {
+        const int indexZero = static_cast<int>( (key & sequenceMask) * 4);
+        for(int offset : {0, 1, 2, 3, 1, 2})
+            *indexIter++ = indexZero + offset;
+    }
+
+    // Each contiguous run with the same layer and texture is rendered as one batch
+    mLastRenderStats = {0, mVertexLst.size()};
+    for(size_t runBegin = 0; runBegin < quadCount; ) {
+        const uint64_t runKey = mDrawKeyLst[runBegin] >> sequenceBits;
+        size_t runEnd = runBegin + 1;
+        while(runEnd < quadCount && (mDrawKeyLst[runEnd] >> sequenceBits) == runKey)
+            ++runEnd;
         SDL_RenderGeometry(
-            mRenderer.get(), batch.texture,
-            batch.vertexLst.data(), static_cast<int>(batch.vertexLst.size() ),
-            batch.indexLst.data(), static_cast<int>(batch.indexLst.size() )
+            mRenderer.get(), mTextureLst[runKey & textureMask],
+            mVertexLst.data(), static_cast<int>(mVertexLst.size() ),
+            indexLst.data() + runBegin * 6, static_cast<int>( (runEnd - runBegin) * 6)
         );
+        runBegin = runEnd;
+        ++mLastRenderStats.drawCallCount;
     }
-    mBatchLst.clear();
+    mVertexLst.clear();
+    mDrawKeyLst.clear();
+    mTextureLst.clear();
+
     // Update the screen with the drawn elements
     SDL_RenderPresent(mRenderer.get() );
 }
 
+void Window::addQuad(SDL_Texture* texture, DrawLayer layer, const std::array<SDL_Vertex, 4>& quad) {
+    const uint64_t sequence = mDrawKeyLst.size();
+    assert(sequence <= sequenceMask && "Too many quads drawn in one frame");
+    mDrawKeyLst.push_back(packDrawKey(layer, getTextureIndex(texture), sequence) );
+    mVertexLst.insert(mVertexLst.end(), quad.begin(), quad.end() );
+}
+
+uint64_t Window::getTextureIndex(SDL_Texture* texture) {
+    const size_t textureCount = mTextureLst.size();
+    for(size_t i=0; i<textureCount; ++i) {
+        if(mTextureLst[i] == texture)
+            return i;
+    }
+    assert(textureCount <= textureMask && "Too many textures drawn in one frame");
+    mTextureLst.push_back(texture);
+    return textureCount;
+}
+
 
 } // namespace Media
 
@@ -3,26 +3,37 @@
 #define HPP_MEDIA_WINDOW_141663353574_
 
 #include "camera.hpp"
+#include "quad_vertices.hpp"
+#include "sprite.hpp"
 
 #include "../util/cstring_view.hpp"
+#include "../util/default_init_allocator.hpp"
 #include "../util/rect.hpp"
+#include "../util/rect_arrays.hpp"
 #include "../util/typedefs.hpp"
 
 #include <SDL_FontCache/SDL_FontCache.h>
 
 #include <SDL2/SDL_render.h>
 
+#include <array>
+#include <cassert>
 #include <memory>
 #include <span>
 #include <vector>
 #include <utility>
 
 
+namespace Util
+{
+class MemoryReport;
+} // namespace Util
+
+
 namespace Media
 {
 
 
-class Sprite;
 class Drawable;
 
 struct SDLRendererWindowDeleter {
@@ -55,6 +66,28 @@ createSDLRendererWindow(Util::CStringView title, PixelDisplacement windowSize, U
 std::span<const uint8_t> keyboardState();
 
 
+/**
+ * @brief The layers that are drawn from back to front
+ * @note Within a layer, draws are grouped by texture so the order between different textures is unspecified
+ */
+enum class DrawLayer : uint8_t {
+    background,
+    world,
+    foreground,
+    interface,
+    overlay,
+};
+
+
+/**
+ * @brief What was rendered by the last Window::display()
+ */
+struct RenderStats {
+    size_t drawCallCount;
+    size_t vertexCount;
+};
+
+
 /**
  * @brief A window for 2D rendering.
  */
@@ -63,29 +96,86 @@ public:
     explicit Window(SDLRendererUniquePtr&& renderer_, SDLWindowUniquePtr&& window_);
 
     PixelDisplacement currentSize() const;
+    [[nodiscard]] RenderStats lastRenderStats() const;
     Util::BasePosition mouseWorldCoord() const;
 
+    /**
+     * @brief Make room for drawing quadCount quads in a frame, so that drawing them doesn't allocate
+     */
+    void reserveQuads(size_t quadCount);
+    /**
+     * @brief Add the capacities of the batches
+     */
+    void reportMemory(Util::MemoryReport& report) const;
     void clear();
     void draw(const Drawable& drawable);
-    void draw(const Sprite& sprite, const Util::BaseRect& posRect);
-    void draw(const PixelRect& rect, SDL_Colour colour);
-    void draw(FC_Font* font, PixelPosition leftTop, Util::CStringView text);
+    void draw(const Sprite& sprite, const Util::BaseRect& posRect, DrawLayer layer = DrawLayer::world);
+    /**
+     * @brief Draw many quads with the same texture, the ones outside of the view are culled
+     * @note Large submissions have their vertices built across the worker threads,
+     *       the result is identical to building them on one thread
+     */
+    void draw(SDL_Texture* texture, const QuadArrays& quads, DrawLayer layer = DrawLayer::world);
+    /**
+     * @brief Start drawing up to maxCount sprites in bulk, each added with addSprite
+     * @note Each run of sprites with the same texture is submitted as one QuadArrays,
+     *       so the texture and batch are looked up once per run instead of once per sprite
+     * @note The sprites are drawn by endSprites, and no other sprites can be drawn until then
+     * @example window.beginSprites(count, layer); for(...) window.addSprite(sprite, posRect); window.endSprites();
+     */
+    void beginSprites(size_t maxCount, DrawLayer layer = DrawLayer::world);
+    void addSprite(const Sprite& sprite, const Util::BaseRect& posRect);
+    void endSprites();
+    void draw(const PixelRect& rect, SDL_Colour colour, DrawLayer layer = DrawLayer::interface);
+    void draw(FC_Font* font, PixelPosition leftTop, Util::CStringView text, DrawLayer layer = DrawLayer::interface);
     void display();
 
 private:
-    struct TextureBatch {
-        SDL_Texture* texture;
-        std::vector<SDL_Vertex> vertexLst;
-        std::vector<int> indexLst;
-    };
+    // Draws the gathered sprites in [begin, end), which all use the texture
+    void drawSpriteRun(SDL_Texture* texture, size_t begin, size_t end, DrawLayer layer);
+    void addQuad(SDL_Texture* texture, DrawLayer layer, const std::array<SDL_Vertex, 4>& quad);
+    [[nodiscard]] uint64_t getTextureIndex(SDL_Texture* texture);
 
     SDLWindowUniquePtr mWindow;
     SDLRendererUniquePtr mRenderer;
     Camera mCamera;
-    std::vector<TextureBatch> mBatchLst{};
+    // The quads submitted this frame, with a packed (layer, texture, sequence) draw key for each quad
+    std::vector<SDL_Vertex, Util::DefaultInitAllocator<SDL_Vertex> > mVertexLst{};
+    std::vector<uint64_t> mDrawKeyLst{};
+    std::vector<SDL_Texture*> mTextureLst{};
+    // The sprites gathered by addSprite, kept between frames so that gathering them doesn't allocate
+    // The texture rects are in pixels until their run is drawn
+    Util::BaseRectArrays mSpriteRectLst{};
+    std::vector<float> mSpriteTextureLeftLst{};
+    std::vector<float> mSpriteTextureTopLst{};
+    std::vector<float> mSpriteTextureRightLst{};
+    std::vector<float> mSpriteTextureBottomLst{};
+    size_t mSpriteCount{};
+    size_t mSpriteRunBegin{};
+    SDL_Texture* rSpriteRunTexture{};
+    DrawLayer mSpriteLayer{};
+    // The scratch data for sorting, batching and culling the quads is in the frame arena
+    RenderStats mLastRenderStats{};
 };
 
 
+inline void Window::addSprite(const Sprite& sprite, const Util::BaseRect& posRect) {
+    assert(mSpriteCount < mSpriteRectLst.size() && "More sprites than beginSprites made room for");
+    if(sprite.getTexture() != rSpriteRunTexture) {
+        drawSpriteRun(rSpriteRunTexture, mSpriteRunBegin, mSpriteCount, mSpriteLayer);
+        rSpriteRunTexture = sprite.getTexture();
+        mSpriteRunBegin = mSpriteCount;
+    }
+    const PixelRect textureRect = sprite.getRect();
+    mSpriteRectLst.set(mSpriteCount, posRect);
+    mSpriteTextureLeftLst[mSpriteCount] = textureRect.left().value;
+    mSpriteTextureTopLst[mSpriteCount] = textureRect.top().value;
+    mSpriteTextureRightLst[mSpriteCount] = textureRect.right().value;
+    mSpriteTextureBottomLst[mSpriteCount] = textureRect.bottom().value;
+    ++mSpriteCount;
+}
+
+
 }// namespace Media
 
 #endif // ifndef HPP_MEDIA_WINDOW_141663353574_
@@ -11,14 +11,12 @@ namespace Menu
 
 using namespace Util::Udl;
 using namespace Media::Udl;
-using namespace std::string_literals;
 
 
 GameOverState::GameOverState(Media::GameContext& ctx_, Util::Second timeSurvived_) :
-    Media::GameState{ctx_},
-    mTimeSurvived{"Time survived: "s + std::to_string(timeSurvived_.value) + "s"s}
+    Media::GameState{ctx_}
 {
-    rCtx.resourceManager.loadFont(u8"fonts/andika_regular.ttf", "andika");
+    mTimeSurvived.append("Time survived: ").append(timeSurvived_, {.precision = 2});
     mFont = rCtx.resourceManager.getFont("andika");
 }
 
@@ -34,8 +32,6 @@ void GameOverState::draw() {
 
     const Media::PixelPosition fontLeftTop = {200_pl, 200_pl};
     window.draw(mFont, fontLeftTop, mTimeSurvived);
-
-    window.display();
 }
 
 
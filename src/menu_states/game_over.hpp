@@ -3,11 +3,10 @@
 #define HPP_MENUSTATES_GAMEOVER_
 
 #include "../media/game_state.hpp"
+#include "../util/format_buffer.hpp"
 
 #include <SDL_FontCache/SDL_FontCache.h>
 
-#include <string>
-
 
 namespace Menu
 {
@@ -22,7 +21,7 @@ public:
     void draw() override;
 
 private:
-    std::string mTimeSurvived{};
+    Util::FormatBuffer<48> mTimeSurvived{};
     FC_Font* mFont{};
 };
 
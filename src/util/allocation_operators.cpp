@@ -0,0 +1,68 @@
+
+#include "allocation_tracking.hpp"
+
+#include <cstdlib>
+#include <new>
+
+
+// The replaced global operator new and delete, which only the game's executable is built with,
+// as replacing them in the library would also count the allocations of the benchmarks
+// Only the single object forms are replaced, since the default array and nothrow forms call them.
+// The sized forms are replaced too, since some compilers warn otherwise.
+#ifdef UTIL_ENABLE_ALLOCATION_TRACKING
+
+namespace
+{
+
+
+// Dynamically initialised before main, so the scopes and the totals are reported from the start of the game
+[[maybe_unused]] const bool gIsTrackingEnabled = (Util::enableAllocationTracking(), true);
+
+
+} // namespace
+
+
+void* operator new(size_t size) {
+    Util::countGlobalAllocation(size);
+    if(void* ptr = std::malloc(size == 0 ? 1 : size) )
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    Util::countGlobalAllocation(size);
+    const auto align = static_cast<size_t>(alignment);
+    // aligned_alloc needs the size to be a multiple of the alignment
+    const size_t alignedSize = (size + align - 1) / align * align;
+#ifdef _WIN32
+    if(void* ptr = _aligned_malloc(alignedSize == 0 ? align : alignedSize, align) )
+#else
+    if(void* ptr = std::aligned_alloc(align, alignedSize == 0 ? align : alignedSize) )
+#endif // ifdef _WIN32
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    Util::countGlobalDeallocation(ptr);
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    Util::countGlobalDeallocation(ptr);
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif // ifdef _WIN32
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept {
+    operator delete(ptr, alignment);
+}
+
+#endif // ifdef UTIL_ENABLE_ALLOCATION_TRACKING
@@ -0,0 +1,129 @@
+
+#include "allocation_tracking.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+
+
+namespace Util
+{
+
+
+namespace
+{
+
+
+std::atomic<uint64_t> gAllocationCount{0};
+std::atomic<uint64_t> gDeallocationCount{0};
+std::atomic<uint64_t> gAllocatedBytes{0};
+// Constant initialised, so it's false until the counting operators are constructed
+std::atomic<bool> gIsTrackingEnabled{false};
+
+// Constant initialised, so using it from operator new can't allocate
+thread_local AllocationScope* tCurrentScope = nullptr;
+
+// The totals of the ended scopes, by name
+// Slots are claimed without locking, the names of later scopes are dropped once it's full
+struct ScopeTotal {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> allocationCount{0};
+    std::atomic<uint64_t> allocatedBytes{0};
+};
+constexpr size_t scopeTotalCapacity = 64;
+std::array<ScopeTotal, scopeTotalCapacity> gScopeTotalLst{};
+
+ScopeTotal* findScopeTotal(const char* name) {
+    for(auto& total : gScopeTotalLst) {
+        const char* totalName = total.name.load(std::memory_order_acquire);
+        if(!totalName && total.name.compare_exchange_strong(totalName, name, std::memory_order_acq_rel) )
+            return &total;
+        // Copies of the same string literal can have different addresses
+        if(totalName == name || std::strcmp(totalName, name) == 0)
+            return &total;
+    }
+    return nullptr;
+}
+
+
+} // namespace
+
+
+bool isAllocationTrackingEnabled() {
+    return gIsTrackingEnabled.load(std::memory_order_relaxed);
+}
+
+void enableAllocationTracking() noexcept {
+    gIsTrackingEnabled.store(true, std::memory_order_relaxed);
+}
+
+void countGlobalAllocation(size_t size) noexcept {
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if(tCurrentScope)
+        tCurrentScope->countAllocation(size);
+}
+
+void countGlobalDeallocation(void* ptr) noexcept {
+    if(ptr)
+        gDeallocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocationStats allocationStats() {
+    return {
+        gAllocationCount.load(std::memory_order_relaxed),
+        gDeallocationCount.load(std::memory_order_relaxed),
+        gAllocatedBytes.load(std::memory_order_relaxed),
+    };
+}
+
+
+AllocationScope::AllocationScope(const char* name_, AllocationPolicy policy_) noexcept :
+    mName{name_},
+    rParent{tCurrentScope},
+    mIsForbidden{policy_ == AllocationPolicy::forbid || (policy_ == AllocationPolicy::inherit && rParent && rParent->mIsForbidden)}
+{
+    tCurrentScope = this;
+}
+
+AllocationScope::~AllocationScope() {
+    tCurrentScope = rParent;
+    if(mAllocationCount == 0)
+        return;
+    if(ScopeTotal* total = findScopeTotal(mName) ) {
+        total->allocationCount.fetch_add(mAllocationCount, std::memory_order_relaxed);
+        total->allocatedBytes.fetch_add(mAllocatedBytes, std::memory_order_relaxed);
+    }
+}
+
+void AllocationScope::countAllocation(size_t size) noexcept {
+    if(mIsForbidden) {
+        // Can't use iostreams, since they could allocate
+        std::fprintf(stderr, "Allocated %zu bytes in \"%s\", where allocations are forbidden\n", size, mName);
+        std::abort();
+    }
+    ++mAllocationCount;
+    mAllocatedBytes += size;
+}
+
+void writeAllocationScopes(std::ostream& os) {
+    const auto flags = os.flags();
+    os<<"Allocations by scope\n";
+    os<<std::left<<std::setw(32)<<"scope"<<std::right<<std::setw(14)<<"allocations"<<std::setw(16)<<"bytes"<<'\n';
+    for(const auto& total : gScopeTotalLst) {
+        const char* name = total.name.load(std::memory_order_acquire);
+        if(!name)
+            break;
+        os<<std::left<<std::setw(32)<<name<<std::right
+          <<std::setw(14)<<total.allocationCount.load(std::memory_order_relaxed)
+          <<std::setw(16)<<total.allocatedBytes.load(std::memory_order_relaxed)<<'\n';
+    }
+    os.flags(flags);
+}
+
+
+} // namespace Util
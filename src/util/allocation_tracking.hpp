@@ -0,0 +1,114 @@
+
+#ifndef HPP_UTIL_ALLOCATION_TRACKING_
+#define HPP_UTIL_ALLOCATION_TRACKING_
+
+#include "macros.hpp"
+#include "typedefs.hpp"
+
+#include <iosfwd>
+
+
+/**
+ * UTIL_ALLOCATION_SCOPE(name) counts the allocations made by this thread in the rest of the enclosing scope
+ * UTIL_FORBID_ALLOCATION(name, isActive) also aborts on any allocation by this thread in the rest of the scope,
+ *     if isActive is true
+ * UTIL_ALLOW_ALLOCATION(name) allows allocations again in the rest of the scope, e.g for expected growth
+ * The name must be a string literal (or have static storage duration)
+ * These only do anything if UTIL_ENABLE_ALLOCATION_TRACKING is defined, otherwise they compile to nothing,
+ *     and they only count in the game, which is linked with the counting operator new
+ * @example void update() { UTIL_FORBID_ALLOCATION("update", isWarmedUp); ... }
+ */
+/*NO-FORMAT*/
+#ifdef UTIL_ENABLE_ALLOCATION_TRACKING
+    #define UTIL_ALLOCATION_SCOPE(NAME) \
+        const ::Util::AllocationScope UTIL_CONCAT(utilAllocationScope_, __LINE__){NAME, ::Util::AllocationPolicy::inherit}
+    #define UTIL_FORBID_ALLOCATION(NAME, IS_ACTIVE) \
+        const ::Util::AllocationScope UTIL_CONCAT(utilAllocationScope_, __LINE__){NAME, \
+            (IS_ACTIVE) ? ::Util::AllocationPolicy::forbid : ::Util::AllocationPolicy::inherit}
+    #define UTIL_ALLOW_ALLOCATION(NAME) \
+        const ::Util::AllocationScope UTIL_CONCAT(utilAllocationScope_, __LINE__){NAME, ::Util::AllocationPolicy::allow}
+#else
+    #define UTIL_ALLOCATION_SCOPE(NAME) do{}while(false)
+    #define UTIL_FORBID_ALLOCATION(NAME, IS_ACTIVE) do{}while(false)
+    #define UTIL_ALLOW_ALLOCATION(NAME) do{}while(false)
+#endif // ifdef UTIL_ENABLE_ALLOCATION_TRACKING
+/*YES-FORMAT*/
+
+
+namespace Util
+{
+
+
+/**
+ * @brief Totals of the global operator new/delete calls, from every thread
+ */
+struct AllocationStats {
+    uint64_t allocationCount;
+    uint64_t deallocationCount;
+    uint64_t allocatedBytes;
+};
+
+/**
+ * @return true if the global operator new/delete are replaced with counting ones,
+ *         which is when the game is built with UTIL_ENABLE_ALLOCATION_TRACKING
+ */
+[[nodiscard]] bool isAllocationTrackingEnabled();
+
+/**
+ * @return the totals so far, or zeros if allocation tracking isn't enabled
+ */
+[[nodiscard]] AllocationStats allocationStats();
+
+
+// For the counting operator new and delete in allocation_operators.cpp
+
+void enableAllocationTracking() noexcept;
+
+/**
+ * @brief Add the allocation to the totals and to the calling thread's innermost scope
+ */
+void countGlobalAllocation(size_t size) noexcept;
+
+void countGlobalDeallocation(void* ptr) noexcept;
+
+
+enum class AllocationPolicy : uint8_t {
+    inherit, // Same as the enclosing scope
+    forbid,
+    allow,
+};
+
+/**
+ * @brief Counts the allocations that its thread makes while it's the innermost scope,
+ *        and adds them to the totals of its name when it ends
+ * @note Use the UTIL_*_ALLOCATION macros instead, so that it can be compiled out
+ */
+class AllocationScope {
+public:
+    AllocationScope(const char* name_, AllocationPolicy policy_) noexcept;
+    ~AllocationScope();
+    AllocationScope& operator=(AllocationScope&&) = delete; // no copy nor move
+
+    /**
+     * @brief Called by the global operator new for the calling thread's innermost scope
+     * @note Aborts with a message if allocations are forbidden in the scope
+     */
+    void countAllocation(size_t size) noexcept;
+
+private:
+    const char* mName;
+    AllocationScope* rParent;
+    uint64_t mAllocationCount{};
+    uint64_t mAllocatedBytes{};
+    bool mIsForbidden;
+};
+
+/**
+ * @brief Write the totals of every scope name that has counted an allocation
+ */
+void writeAllocationScopes(std::ostream& os);
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_ALLOCATION_TRACKING_
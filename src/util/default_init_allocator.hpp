@@ -0,0 +1,46 @@
+
+#ifndef HPP_UTIL_DEFAULTINITALLOCATOR_
+#define HPP_UTIL_DEFAULTINITALLOCATOR_
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief An allocator that default-initialises instead of value-initialises
+ * @note So that resize() on a vector of trivial types doesn't zero memory that is about to be overwritten
+ * @example std::vector<SDL_Vertex, DefaultInitAllocator<SDL_Vertex> > vertexLst;
+ */
+template<typename T, typename A = std::allocator<T> >
+class DefaultInitAllocator : public A {
+    using Traits = std::allocator_traits<A>;
+
+public:
+    template<typename U>
+    struct rebind {
+        using other = DefaultInitAllocator<U, typename Traits::template rebind_alloc<U> >;
+    };
+
+    using A::A;
+
+    template<typename U>
+    void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>) {
+        ::new(static_cast<void*>(ptr) ) U;
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* ptr, Args&&... args) {
+        Traits::construct(static_cast<A&>(*this), ptr, std::forward<Args>(args)...);
+    }
+};
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_DEFAULTINITALLOCATOR_
@@ -19,8 +19,6 @@ namespace Util
 {
 
 
-using Real = float;
-
 /**
  * @brief Strong typed dimension to represent phyiscal quantities
  * @tparam T - the underlying arithmetic type
@@ -350,7 +348,9 @@ template<typename T, int L, int M, int S, typename R>
     static_assert(isEven(L), "length dimension must be even");
     static_assert(isEven(M), "mass dimension must be even");
     static_assert(isEven(S), "time dimension must be even");
-    return Dim<T, L/2, M/2, S/2, R>{std::sqrt(u.value)};
+    // Found by ADL for fixed-point types
+    using std::sqrt;
+    return Dim<T, L/2, M/2, S/2, R>{sqrt(u.value)};
 }
 
 template<typename T, int L, int M, int S, typename R>
@@ -374,7 +374,8 @@ minMax(const Dim<T, L, M, S, R>& lhs, const Dim<T, L, M, S, R>& rhs) {
 template<typename T, int L, int M, int S, typename R>
 [[nodiscard]] UTIL_ALWAYS_INLINE auto
 abs(const Dim<T, L, M, S, R>& dim) {
-    return Dim<T, L, M, S, R>{std::abs(dim.value)};
+    using std::abs;
+    return Dim<T, L, M, S, R>{abs(dim.value)};
 }
 
 template<typename T, int L, int M, int S, typename R>
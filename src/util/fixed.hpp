@@ -0,0 +1,290 @@
+
+#ifndef HPP_UTIL_FIXED_
+#define HPP_UTIL_FIXED_
+
+#include "macros.hpp"
+#include "typedefs.hpp"
+
+#include <cassert>
+#include <compare>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief The integer types that products and square roots of a fixed-point number are computed in
+ */
+template<typename Raw>
+struct FixedWide;
+
+template<>
+struct FixedWide<int32_t> {
+    using Signed = int64_t;
+    using Unsigned = uint64_t;
+};
+
+#ifdef __SIZEOF_INT128__
+    #define UTIL_HAS_FIXED_64 1
+__extension__ typedef __int128 FixedInt128;
+__extension__ typedef unsigned __int128 FixedUint128;
+
+template<>
+struct FixedWide<int64_t> {
+    using Signed = FixedInt128;
+    using Unsigned = FixedUint128;
+};
+#endif // ifdef __SIZEOF_INT128__
+
+
+/**
+ * @brief A signed fixed-point number, with the lowest FracBits bits of Raw after the binary point
+ * @note Every operation is integer arithmetic, so the results are bit exact on every CPU and compiler
+ * @note Products round to nearest and quotients truncate, overflowing Raw wraps like any integer
+ * @example using Real = Fixed<int64_t, 32>; const Real half = 0.5; const Real one = half * 2;
+ */
+template<typename Raw, int FracBits>
+class Fixed {
+    static_assert(std::is_same_v<Raw, int32_t> || std::is_same_v<Raw, int64_t>, "Fixed needs int32_t or int64_t");
+    static_assert(FracBits > 0 && FracBits < std::numeric_limits<Raw>::digits, "Fixed needs integer bits");
+
+    using UnsignedRaw = std::make_unsigned_t<Raw>;
+    using Wide = typename FixedWide<Raw>::Signed;
+    using UnsignedWide = typename FixedWide<Raw>::Unsigned;
+
+public:
+    using RawType = Raw;
+    inline static constexpr int fractionBits = FracBits;
+    inline static constexpr Raw rawOne = Raw{1} << FracBits;
+
+
+    Fixed() = default;
+
+    /**
+     * @brief Convert from an arithmetic type, rounding floating-point values to nearest
+     * @note Implicit like the conversions between arithmetic types, so that literals and constants mix in
+     * @note Floating-point values must round to within the range, NaN and infinities are a bug
+     */
+    template<typename A, typename E_ = std::enable_if_t<std::is_arithmetic_v<A> > >
+    constexpr UTIL_IMPLICIT Fixed(A value) noexcept :
+        mRaw{toRaw(value)}
+    {}
+
+    [[nodiscard]] constexpr static Fixed fromRaw(Raw raw_) noexcept {
+        Fixed fixed;
+        fixed.mRaw = raw_;
+        return fixed;
+    }
+
+    [[nodiscard]] constexpr Raw raw() const noexcept {
+        return mRaw;
+    }
+
+    /**
+     * @brief Convert to an arithmetic type, integers truncate towards zero
+     */
+    template<typename A, typename E_ = std::enable_if_t<std::is_arithmetic_v<A> > >
+    constexpr explicit operator A() const noexcept {
+        if constexpr(std::is_floating_point_v<A>)
+            return static_cast<A>(mRaw) / static_cast<A>(rawOne);
+        else
+            return static_cast<A>(mRaw / rawOne);
+    }
+
+
+    // Sums are computed unsigned, so that overflowing wraps instead of being undefined
+
+    [[nodiscard]] friend constexpr Fixed operator-(Fixed fixed) noexcept {
+        return fromRaw(static_cast<Raw>(UnsignedRaw{0} - static_cast<UnsignedRaw>(fixed.mRaw) ) );
+    }
+
+    [[nodiscard]] friend constexpr Fixed operator+(Fixed lhs, Fixed rhs) noexcept {
+        return fromRaw(static_cast<Raw>(static_cast<UnsignedRaw>(lhs.mRaw) + static_cast<UnsignedRaw>(rhs.mRaw) ) );
+    }
+
+    [[nodiscard]] friend constexpr Fixed operator-(Fixed lhs, Fixed rhs) noexcept {
+        return fromRaw(static_cast<Raw>(static_cast<UnsignedRaw>(lhs.mRaw) - static_cast<UnsignedRaw>(rhs.mRaw) ) );
+    }
+
+    [[nodiscard]] friend constexpr Fixed operator*(Fixed lhs, Fixed rhs) noexcept {
+        constexpr Wide half = Wide{1} << (FracBits - 1);
+        const Wide product = static_cast<Wide>(lhs.mRaw) * static_cast<Wide>(rhs.mRaw);
+        return fromRaw(static_cast<Raw>( (product + half) >> FracBits) );
+    }
+
+    [[nodiscard]] friend constexpr Fixed operator/(Fixed lhs, Fixed rhs) noexcept {
+        assert(rhs.mRaw != 0 && "Fixed division by zero");
+        const Wide dividend = static_cast<Wide>(lhs.mRaw) * static_cast<Wide>(rawOne);
+        return fromRaw(static_cast<Raw>(dividend / static_cast<Wide>(rhs.mRaw) ) );
+    }
+
+    friend constexpr Fixed& operator+=(Fixed& lhs, Fixed rhs) noexcept {
+        return lhs = lhs + rhs;
+    }
+
+    friend constexpr Fixed& operator-=(Fixed& lhs, Fixed rhs) noexcept {
+        return lhs = lhs - rhs;
+    }
+
+    friend constexpr Fixed& operator*=(Fixed& lhs, Fixed rhs) noexcept {
+        return lhs = lhs * rhs;
+    }
+
+    friend constexpr Fixed& operator/=(Fixed& lhs, Fixed rhs) noexcept {
+        return lhs = lhs / rhs;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(Fixed lhs, Fixed rhs) noexcept = default;
+    [[nodiscard]] friend constexpr std::strong_ordering operator<=>(Fixed lhs, Fixed rhs) noexcept = default;
+
+    friend std::ostream& operator<<(std::ostream& os, Fixed fixed) {
+        return os<<static_cast<double>(fixed);
+    }
+
+    [[nodiscard]] friend constexpr Fixed abs(Fixed fixed) noexcept {
+        return fixed.mRaw < 0 ? -fixed : fixed;
+    }
+
+    /**
+     * @brief The square root rounded down, computed bit by bit, negative values give zero
+     */
+    [[nodiscard]] friend constexpr Fixed sqrt(Fixed fixed) noexcept {
+        assert(fixed.mRaw >= 0 && "Fixed sqrt of a negative number");
+        if(fixed.mRaw <= 0)
+            return Fixed{};
+        // sqrt(raw / one) * one == sqrt(raw * one)
+        UnsignedWide remainder = static_cast<UnsignedWide>(fixed.mRaw) << FracBits;
+        UnsignedWide root = 0;
+        UnsignedWide bit = UnsignedWide{1} << (sizeof(UnsignedWide) * 8 - 2);
+        while(bit > remainder)
+            bit >>= 2;
+        while(bit != 0) {
+            if(remainder >= root + bit) {
+                remainder -= root + bit;
+                root = (root >> 1) + bit;
+            } else {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+        return fromRaw(static_cast<Raw>(root) );
+    }
+
+private:
+    template<typename A>
+    [[nodiscard]] constexpr static Raw toRaw(A value) noexcept {
+        if constexpr(std::is_floating_point_v<A>) {
+            // Scaling a double by a power of two is exact, and rounding without adding 0.5 keeps it exact,
+            // so the result doesn't depend on the precision of the platform's floating-point
+            const double scaled = static_cast<double>(value) * static_cast<double>(rawOne);
+            // Also false for NaN, converting it or a value out of range to Raw would be undefined
+            assert(scaled > static_cast<double>(std::numeric_limits<Raw>::min() ) - 0.5 &&
+                   scaled < static_cast<double>(std::numeric_limits<Raw>::max() ) + 0.5 &&
+                   "The value is out of the range of Fixed");
+            auto rounded = static_cast<Raw>(scaled);
+            const double fraction = scaled - static_cast<double>(rounded);
+            if(fraction >= 0.5)
+                ++rounded;
+            else if(fraction <= -0.5)
+                --rounded;
+            return rounded;
+        } else {
+            return static_cast<Raw>(static_cast<UnsignedRaw>(value) << FracBits);
+        }
+    }
+
+    Raw mRaw;
+};
+
+
+}  // namespace Util
+
+
+template<typename Raw, int FracBits>
+struct std::numeric_limits<Util::Fixed<Raw, FracBits> > {
+private:
+    using F = Util::Fixed<Raw, FracBits>;
+
+public:
+    inline static constexpr bool is_specialized = true;
+    inline static constexpr bool is_signed = true;
+    inline static constexpr bool is_integer = false;
+    inline static constexpr bool is_exact = true;
+    inline static constexpr bool has_infinity = false;
+    inline static constexpr bool has_quiet_NaN = false;
+    inline static constexpr bool has_signaling_NaN = false;
+    inline static constexpr std::float_denorm_style has_denorm = std::denorm_absent;
+    inline static constexpr bool has_denorm_loss = false;
+    // Conversions and products round to nearest, but quotients truncate towards zero
+    inline static constexpr std::float_round_style round_style = std::round_indeterminate;
+    inline static constexpr bool is_iec559 = false;
+    inline static constexpr bool is_bounded = true;
+    // Sums and differences wrap around, like the unsigned integers
+    inline static constexpr bool is_modulo = true;
+    inline static constexpr int digits = std::numeric_limits<Raw>::digits;
+    inline static constexpr int digits10 = std::numeric_limits<Raw>::digits10;
+    inline static constexpr int max_digits10 = 0;
+    inline static constexpr int radix = 2;
+    inline static constexpr int min_exponent = 0;
+    inline static constexpr int min_exponent10 = 0;
+    inline static constexpr int max_exponent = 0;
+    inline static constexpr int max_exponent10 = 0;
+    inline static constexpr bool traps = false;
+    inline static constexpr bool tinyness_before = false;
+
+    // The smallest positive value, like min() of the floating-point types
+    [[nodiscard]] static constexpr F min() noexcept { return F::fromRaw(1); }
+    [[nodiscard]] static constexpr F max() noexcept { return F::fromRaw(std::numeric_limits<Raw>::max() ); }
+    [[nodiscard]] static constexpr F lowest() noexcept { return F::fromRaw(std::numeric_limits<Raw>::min() ); }
+    [[nodiscard]] static constexpr F epsilon() noexcept { return F::fromRaw(1); }
+    // A whole step, as quotients truncate
+    [[nodiscard]] static constexpr F round_error() noexcept { return F::fromRaw(1); }
+    // Zero like the integer types, as there is no infinity nor NaN
+    [[nodiscard]] static constexpr F infinity() noexcept { return F{}; }
+    [[nodiscard]] static constexpr F quiet_NaN() noexcept { return F{}; }
+    [[nodiscard]] static constexpr F signaling_NaN() noexcept { return F{}; }
+    // There are no denormals, so it's min() like the floating-point types without them
+    [[nodiscard]] static constexpr F denorm_min() noexcept { return min(); }
+};
+
+
+namespace Util
+{
+
+
+template<typename T>
+inline constexpr bool isFixed = false;
+template<typename Raw, int FracBits>
+inline constexpr bool isFixed<Fixed<Raw, FracBits> > = true;
+
+
+/**
+ * @brief Checks if lhs and rhs are within eps of each other, relative to their size when it's above one
+ * @note The fixed-point version of nearly_equal in real.hpp
+ */
+template<typename Raw, int FracBits>
+[[nodiscard]] constexpr bool
+nearly_equal(Fixed<Raw, FracBits> lhs, Fixed<Raw, FracBits> rhs,
+             Fixed<Raw, FracBits> eps = std::numeric_limits<Fixed<Raw, FracBits> >::epsilon() ) noexcept
+{
+    using F = Fixed<Raw, FracBits>;
+    const F diff = abs(lhs - rhs);
+    const F absSum = abs(lhs) + abs(rhs);
+    return diff <= eps || diff <= eps * absSum;
+}
+
+
+// Q16.16 only reaches 32768, so squared distances overflow it, Q32.32 is the one to use as Real
+using Q16_16 = Fixed<int32_t, 16>;
+#ifdef UTIL_HAS_FIXED_64
+using Q32_32 = Fixed<int64_t, 32>;
+#endif // ifdef UTIL_HAS_FIXED_64
+
+
+}  // namespace Util
+
+#endif  // HPP_UTIL_FIXED_
@@ -0,0 +1,182 @@
+
+#ifndef HPP_UTIL_FLATMAP_
+#define HPP_UTIL_FLATMAP_
+
+#include "small_vector.hpp"
+#include "static_vector.hpp"
+#include "typedefs.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief A map stored as a sorted array of key-value pairs, so lookups are a binary search through contiguous memory
+ * @tparam Compare - orders the keys, std::less<> also finds std::string keys with a std::string_view
+ * @tparam Container - where the pairs are stored, e.g. a StaticVector for a constexpr table
+ * @note Inserting and erasing move the later pairs, so it's for maps that are mostly read
+ */
+template<typename Key, typename Value, typename Compare = std::less<>,
+         typename Container = std::vector<std::pair<Key, Value> > >
+class FlatMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using iterator = typename Container::iterator;
+    using const_iterator = typename Container::const_iterator;
+
+
+    constexpr FlatMap() = default;
+
+    /**
+     * @note Like std::map, only the first of the pairs with equal keys is kept
+     */
+    constexpr FlatMap(std::initializer_list<value_type> init) {
+        for(const auto& pair : init)
+            insert(pair);
+    }
+
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return mPairLst.size();
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return mPairLst.empty();
+    }
+
+    [[nodiscard]] constexpr iterator begin() noexcept {
+        return mPairLst.begin();
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return mPairLst.begin();
+    }
+
+    [[nodiscard]] constexpr iterator end() noexcept {
+        return mPairLst.end();
+    }
+
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return mPairLst.end();
+    }
+
+
+    // Lookup
+
+    template<typename K>
+    [[nodiscard]] constexpr iterator find(const K& key) {
+        const auto iter = lowerBound(mPairLst.begin(), mPairLst.end(), key);
+        return (iter != mPairLst.end() && !mCompare(key, iter->first) ) ? iter : mPairLst.end();
+    }
+
+    template<typename K>
+    [[nodiscard]] constexpr const_iterator find(const K& key) const {
+        const auto iter = lowerBound(mPairLst.begin(), mPairLst.end(), key);
+        return (iter != mPairLst.end() && !mCompare(key, iter->first) ) ? iter : mPairLst.end();
+    }
+
+    template<typename K>
+    [[nodiscard]] constexpr bool contains(const K& key) const {
+        return find(key) != end();
+    }
+
+    /**
+     * @throws std::out_of_range if there's no such key
+     */
+    template<typename K>
+    [[nodiscard]] constexpr Value& at(const K& key) {
+        const auto iter = find(key);
+        if(iter == end() )
+            throw std::out_of_range("FlatMap has no value with that key");
+        return iter->second;
+    }
+
+    /**
+     * @throws std::out_of_range if there's no such key
+     */
+    template<typename K>
+    [[nodiscard]] constexpr const Value& at(const K& key) const {
+        const auto iter = find(key);
+        if(iter == end() )
+            throw std::out_of_range("FlatMap has no value with that key");
+        return iter->second;
+    }
+
+
+    // Modifiers
+
+    /**
+     * @brief Insert the pair, unless there's already a value with its key
+     * @return the pair with the key, and whether it was inserted
+     */
+    constexpr std::pair<iterator, bool> insert(value_type pair) {
+        const auto iter = lowerBound(mPairLst.begin(), mPairLst.end(), pair.first);
+        if(iter != mPairLst.end() && !mCompare(pair.first, iter->first) )
+            return {iter, false};
+        return {mPairLst.insert(iter, std::move(pair) ), true};
+    }
+
+    /**
+     * @brief Construct a value with args and insert it, unless there's already a value with the key
+     * @return the pair with the key, and whether it was inserted
+     */
+    template<typename K, typename... Args>
+    constexpr std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const auto iter = lowerBound(mPairLst.begin(), mPairLst.end(), key);
+        if(iter != mPairLst.end() && !mCompare(key, iter->first) )
+            return {iter, false};
+        return {mPairLst.insert(iter, value_type(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key) ),
+                                                 std::forward_as_tuple(std::forward<Args>(args)...) ) ), true};
+    }
+
+    /**
+     * @return the number of pairs erased, 0 or 1
+     */
+    template<typename K>
+    constexpr size_t erase(const K& key) {
+        const auto iter = find(key);
+        if(iter == end() )
+            return 0;
+        mPairLst.erase(iter);
+        return 1;
+    }
+
+    constexpr void clear() {
+        mPairLst.clear();
+    }
+
+private:
+    template<typename I, typename K>
+    [[nodiscard]] constexpr I lowerBound(I first, I last, const K& key) const {
+        return std::lower_bound(first, last, key, [this](const value_type& pair, const K& k) {
+            return mCompare(pair.first, k);
+        });
+    }
+
+    Container mPairLst{};
+    [[no_unique_address]] Compare mCompare{};
+};
+
+
+// Typedefs for the inline containers
+
+template<typename Key, typename Value, size_t N, typename Compare = std::less<> >
+using StaticFlatMap = FlatMap<Key, Value, Compare, StaticVector<std::pair<Key, Value>, N> >;
+
+template<typename Key, typename Value, size_t N, typename Compare = std::less<> >
+using SmallFlatMap = FlatMap<Key, Value, Compare, SmallVector<std::pair<Key, Value>, N> >;
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_FLATMAP_
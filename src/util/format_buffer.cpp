@@ -0,0 +1,48 @@
+
+#include "format_buffer.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+
+namespace Util
+{
+
+
+namespace
+{
+
+
+// 17 significant digits round-trip any double, so a larger precision would only add noise. It also keeps
+// a scientific number well within maxNumberLength, and leaves 22 characters, with the sign, before the point
+constexpr int maxPrecision = 17;
+
+
+} // namespace
+
+
+size_t formatNumber(double value, int precision, std::span<char, maxNumberLength> out) {
+    char* const first = out.data();
+    char* const last = out.data() + out.size();
+    const int clampedPrecision = std::clamp(precision, 0, maxPrecision);
+    // NaN and infinity are written by to_chars as "nan" and "inf"
+    auto result = std::to_chars(first, last, value, std::chars_format::fixed, clampedPrecision);
+    if(result.ec != std::errc{})
+        result = std::to_chars(first, last, value, std::chars_format::scientific, clampedPrecision);
+    if(result.ec != std::errc{})
+        result = std::to_chars(first, last, value);
+    return result.ec == std::errc{} ? static_cast<size_t>(result.ptr - first) : 0;
+}
+
+size_t formatNumber(int64_t value, std::span<char, maxNumberLength> out) {
+    const auto result = std::to_chars(out.data(), out.data() + out.size(), value);
+    return static_cast<size_t>(result.ptr - out.data() );
+}
+
+size_t formatNumber(uint64_t value, std::span<char, maxNumberLength> out) {
+    const auto result = std::to_chars(out.data(), out.data() + out.size(), value);
+    return static_cast<size_t>(result.ptr - out.data() );
+}
+
+
+} // namespace Util
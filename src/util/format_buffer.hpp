@@ -0,0 +1,145 @@
+
+#ifndef HPP_UTIL_FORMATBUFFER_
+#define HPP_UTIL_FORMATBUFFER_
+
+#include "cstring_view.hpp"
+#include "dimension.hpp"
+#include "fixed.hpp"
+#include "macros.hpp"
+#include "typedefs.hpp"
+
+#include <algorithm>
+#include <array>
+#include <ratio>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief How a number is written by FormatBuffer
+ */
+struct NumberFormat {
+    // Digits after the decimal point, integers have none
+    int precision = 2;
+    // Padded with spaces on the left to at least this many characters
+    int width = 0;
+};
+
+
+// The longest number formatNumber writes, larger values switch to scientific notation
+inline constexpr size_t maxNumberLength = 40;
+
+/**
+ * @brief Write value with std::to_chars, without the null terminator
+ * @return the number of characters written to out
+ */
+size_t formatNumber(double value, int precision, std::span<char, maxNumberLength> out);
+size_t formatNumber(int64_t value, std::span<char, maxNumberLength> out);
+size_t formatNumber(uint64_t value, std::span<char, maxNumberLength> out);
+
+
+/**
+ * @brief The symbol written after a quantity of this Dim, empty for units without one
+ * @note Specialise it for other units, e.g. template<> inline constexpr std::string_view unitSuffix<Metre> = "m";
+ */
+template<typename D>
+inline constexpr std::string_view unitSuffix = "";
+
+template<typename T>
+inline constexpr std::string_view unitSuffix<Duration<T, BaseRatio> > = "s";
+template<typename T>
+inline constexpr std::string_view unitSuffix<Duration<T, std::milli> > = "ms";
+template<typename T>
+inline constexpr std::string_view unitSuffix<Duration<T, std::micro> > = "us";
+template<typename T>
+inline constexpr std::string_view unitSuffix<Frequency<T, BaseRatio> > = "Hz";
+template<typename T>
+inline constexpr std::string_view unitSuffix<Length<T, BaseRatio> > = "bl";
+template<typename T>
+inline constexpr std::string_view unitSuffix<Speed<T, BaseRatio> > = "bl/s";
+
+
+/**
+ * @brief A fixed capacity null-terminated string, that numbers and quantities are written to without allocating
+ * @note Text past the capacity is cut off instead of growing the buffer
+ * @example FormatBuffer<32> text; window.draw(font, leftTop, text.append("Time: ").append(time) );
+ */
+template<size_t Capacity>
+class FormatBuffer {
+public:
+    [[nodiscard]] size_t size() const noexcept {
+        return mSize;
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept {
+        return Capacity;
+    }
+
+    FormatBuffer& clear() noexcept {
+        mSize = 0;
+        mBuffer[0] = '\0';
+        return *this;
+    }
+
+    FormatBuffer& append(std::string_view text) noexcept {
+        const size_t count = std::min(text.size(), Capacity - mSize);
+        std::copy_n(text.begin(), count, mBuffer.begin() + static_cast<ptrdiff_t>(mSize) );
+        mSize += count;
+        mBuffer[mSize] = '\0';
+        return *this;
+    }
+
+    /**
+     * @brief Append an arithmetic or fixed-point number, with the precision and width of format
+     */
+    template<typename A, typename E_ = std::enable_if_t<std::is_arithmetic_v<A> || isFixed<A> > >
+    FormatBuffer& appendNumber(A value, NumberFormat format = {}) noexcept {
+        std::array<char, maxNumberLength> digitLst;
+        const size_t length = [&]{
+            if constexpr(std::is_integral_v<A> && std::is_signed_v<A>)
+                return formatNumber(static_cast<int64_t>(value), digitLst);
+            else if constexpr(std::is_integral_v<A>)
+                return formatNumber(static_cast<uint64_t>(value), digitLst);
+            else
+                return formatNumber(static_cast<double>(value), format.precision, digitLst);
+        }();
+        constexpr std::string_view spaces = "                                        ";
+        const size_t padding = std::min(static_cast<size_t>(std::max(format.width, 0) ), spaces.size() );
+        if(padding > length)
+            append(spaces.substr(0, padding - length) );
+        return append({digitLst.data(), length});
+    }
+
+    /**
+     * @brief Append a quantity followed by its unit
+     * @param suffix - written straight after the number, the unit's symbol by default
+     */
+    template<typename T, int L, int M, int S, typename R>
+    FormatBuffer& append(Dim<T, L, M, S, R> quantity, NumberFormat format = {},
+                         std::string_view suffix = unitSuffix<Dim<T, L, M, S, R> >) noexcept
+    {
+        return appendNumber(quantity.value, format).append(suffix);
+    }
+
+    [[nodiscard]] CStringView view() const noexcept {
+        return CStringView{mBuffer.data(), mSize};
+    }
+
+    UTIL_IMPLICIT operator CStringView() const noexcept {
+        return view();
+    }
+
+private:
+    std::array<char, Capacity + 1> mBuffer{};
+    size_t mSize = 0;
+};
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_FORMATBUFFER_
@@ -0,0 +1,98 @@
+
+#include "frame_arena.hpp"
+
+#include <algorithm>
+#include <bit>
+
+
+namespace Util
+{
+
+
+namespace
+{
+
+
+// Enough for the scratch data of a few thousand quads, it grows if a frame needs more
+constexpr size_t defaultFrameArenaCapacity = size_t{1} << 20;
+
+
+} // namespace
+
+
+FrameArena::FrameArena(size_t capacity_) :
+    mBuffer{std::make_unique_for_overwrite<std::byte[]>(capacity_)},
+    mCapacity{capacity_}
+{}
+
+void FrameArena::reset() {
+    const size_t usedBytes = bytesUsed();
+    mPeakBytesUsed = std::max(mPeakBytesUsed, usedBytes);
+    if(mOverflowBytes > 0) {
+        mOverflow.release();
+        mOverflowBytes = 0;
+        // Grow so that a frame like this one fits next time
+        mCapacity = std::bit_ceil(std::max(usedBytes, mCapacity + 1) );
+        mBuffer.reset();
+        mBuffer = std::make_unique_for_overwrite<std::byte[]>(mCapacity);
+    }
+    mOffset = 0;
+}
+
+size_t FrameArena::capacity() const {
+    return mCapacity;
+}
+
+size_t FrameArena::bytesUsed() const {
+    return mOffset + mOverflowBytes;
+}
+
+size_t FrameArena::peakBytesUsed() const {
+    return std::max(mPeakBytesUsed, bytesUsed() );
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    void* ptr = mBuffer.get() + mOffset;
+    size_t space = mCapacity - mOffset;
+    if(std::align(alignment, bytes, ptr, space) ) {
+        mOffset = mCapacity - space + bytes;
+        return ptr;
+    }
+    mOverflowBytes += bytes;
+    return mOverflow.allocate(bytes, alignment);
+}
+
+void FrameArena::do_deallocate(void*, size_t, size_t) {
+    // Freed by reset
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+
+FrameArenas::FrameArenas(size_t capacity_) :
+    mArenaLst{FrameArena{capacity_}, FrameArena{capacity_}}
+{}
+
+FrameArena& FrameArenas::current() {
+    return mArenaLst[mCurrentIndex];
+}
+
+FrameArena& FrameArenas::previous() {
+    return mArenaLst[1 - mCurrentIndex];
+}
+
+void FrameArenas::advanceFrame() {
+    mCurrentIndex = 1 - mCurrentIndex;
+    current().reset();
+}
+
+
+FrameArenas& defaultFrameArenas() {
+    static FrameArenas sFrameArenas{defaultFrameArenaCapacity};
+    return sFrameArenas;
+}
+
+
+} // namespace Util
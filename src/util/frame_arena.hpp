@@ -0,0 +1,98 @@
+
+#ifndef HPP_UTIL_FRAMEARENA_
+#define HPP_UTIL_FRAMEARENA_
+
+#include "default_init_allocator.hpp"
+#include "typedefs.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief A bump allocator for data that only lives until the end of the frame
+ * @note Deallocating does nothing, everything is freed at once by reset()
+ * @note Allocations that don't fit go to the heap, and the buffer grows to fit them at the next reset
+ * @note Not thread safe, allocate from the main thread only
+ */
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    explicit FrameArena(size_t capacity_);
+    FrameArena& operator=(FrameArena&&) = delete; // no copy nor move
+
+    /**
+     * @brief Free everything allocated since the last reset
+     * @note Can allocate, when the buffer grows
+     */
+    void reset();
+
+    [[nodiscard]] size_t capacity() const;
+    [[nodiscard]] size_t bytesUsed() const;
+    [[nodiscard]] size_t peakBytesUsed() const;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::unique_ptr<std::byte[]> mBuffer;
+    size_t mCapacity;
+    size_t mOffset{};
+    std::pmr::monotonic_buffer_resource mOverflow{std::pmr::new_delete_resource()};
+    size_t mOverflowBytes{};
+    size_t mPeakBytesUsed{};
+};
+
+
+/**
+ * @brief Two frame arenas, so that data allocated in a frame can still be read in the next one
+ * @example auto& arena = defaultFrameArenas().current(); ScratchVector<int> lst(&arena);
+ */
+class FrameArenas {
+public:
+    explicit FrameArenas(size_t capacity_);
+
+    /**
+     * @brief The arena of this frame
+     */
+    [[nodiscard]] FrameArena& current();
+    /**
+     * @brief The arena of the last frame, which isn't reset until the end of this frame
+     */
+    [[nodiscard]] FrameArena& previous();
+
+    /**
+     * @brief Start a new frame, which frees the allocations from the frame before the last
+     */
+    void advanceFrame();
+
+private:
+    std::array<FrameArena, 2> mArenaLst;
+    size_t mCurrentIndex{};
+};
+
+
+/**
+ * @brief A vector for scratch data, such as one in a frame arena
+ * @note Default-initialises its elements, like DefaultInitAllocator
+ */
+template<typename T>
+using ScratchVector = std::vector<T, DefaultInitAllocator<T, std::pmr::polymorphic_allocator<T> > >;
+
+
+/**
+ * @brief The frame arenas shared by the game, advanced at the end of every frame
+ */
+[[nodiscard]] FrameArenas& defaultFrameArenas();
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_FRAMEARENA_
@@ -0,0 +1,196 @@
+
+#include "frame_stats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <iomanip>
+#include <ostream>
+
+
+namespace Util
+{
+
+
+namespace
+{
+
+
+constexpr int64_t maxTrackableValue = (int64_t{1} << LatencyHistogram::maxValueBits) - 1;
+
+// Values below 2*subBucketCount get a bucket each,
+// above that each power of two is split into subBucketCount buckets
+size_t bucketIndex(int64_t value) {
+    constexpr uint64_t subBucketCount = LatencyHistogram::subBucketCount;
+    const auto clamped = static_cast<uint64_t>(std::clamp<int64_t>(value, 0, maxTrackableValue) );
+    if(clamped < 2 * subBucketCount)
+        return static_cast<size_t>(clamped);
+    const auto shift = static_cast<unsigned>(std::bit_width(clamped) ) - (LatencyHistogram::subBucketBits + 1);
+    return static_cast<size_t>(shift * subBucketCount + (clamped >> shift) );
+}
+
+int64_t bucketUpperBound(size_t index) {
+    constexpr uint64_t subBucketCount = LatencyHistogram::subBucketCount;
+    if(index < 2 * subBucketCount)
+        return static_cast<int64_t>(index);
+    const uint64_t shift = index / subBucketCount - 1;
+    const uint64_t mantissa = index - shift * subBucketCount;
+    return static_cast<int64_t>( ( (mantissa + 1) << shift) - 1);
+}
+
+int64_t toNanoseconds(Second duration) {
+    return std::max<int64_t>(toChrono<int64_t, std::nano>(duration).count(), 0);
+}
+
+Second toSeconds(int64_t nanoseconds) {
+    return fromChrono<Real, BaseRatio>(std::chrono::nanoseconds{nanoseconds});
+}
+
+volatile std::sig_atomic_t gIsSummaryRequested = 0;
+
+[[maybe_unused]] void requestSummary(int /*signal*/) {
+    gIsSummaryRequested = 1;
+}
+
+
+} // namespace
+
+
+void LatencyHistogram::add(int64_t nanoseconds) {
+    ++mBucketLst[bucketIndex(nanoseconds)];
+    ++mCount;
+}
+
+void LatencyHistogram::remove(int64_t nanoseconds) {
+    auto& bucket = mBucketLst[bucketIndex(nanoseconds)];
+    assert(bucket > 0 && "Removing a duration that wasn't added");
+    --bucket;
+    --mCount;
+}
+
+void LatencyHistogram::clear() {
+    mBucketLst.fill(0);
+    mCount = 0;
+}
+
+uint64_t LatencyHistogram::count() const {
+    return mCount;
+}
+
+int64_t LatencyHistogram::percentile(double fraction) const {
+    if(mCount == 0)
+        return 0;
+    const auto rank = static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(mCount) ) );
+    const uint64_t target = std::max<uint64_t>(rank, 1);
+    uint64_t cumulative = 0;
+    for(size_t i=0; i<bucketCount; ++i) {
+        cumulative += mBucketLst[i];
+        if(cumulative >= target)
+            return bucketUpperBound(i);
+    }
+    return bucketUpperBound(bucketCount - 1);
+}
+
+
+const char* toString(FramePhase phase) {
+    switch(phase) {
+    case FramePhase::frame:
+        return "frame";
+    case FramePhase::input:
+        return "input";
+    case FramePhase::update:
+        return "update";
+    case FramePhase::draw:
+        return "draw";
+    case FramePhase::present:
+        return "present";
+    case FramePhase::tick:
+        return "tick";
+    }
+    return "unknown";
+}
+
+
+void FrameStats::record(FramePhase phase, Second duration) {
+    const int64_t nanoseconds = toNanoseconds(duration);
+    auto& stats = mPhaseLst[static_cast<size_t>(phase)];
+    stats.total.add(nanoseconds);
+    stats.totalMax = std::max(stats.totalMax, nanoseconds);
+
+    // The oldest sample in the window is replaced
+    auto& oldest = stats.windowSampleLst[stats.windowIndex];
+    if(stats.window.count() == windowLength)
+        stats.window.remove(oldest);
+    oldest = nanoseconds;
+    stats.window.add(nanoseconds);
+    stats.windowIndex = (stats.windowIndex + 1) % windowLength;
+}
+
+LatencySummary FrameStats::windowSummary(FramePhase phase) const {
+    const auto& stats = mPhaseLst[static_cast<size_t>(phase)];
+    // Unused samples are zero so they don't affect the maximum
+    const int64_t max = *std::max_element(stats.windowSampleLst.begin(), stats.windowSampleLst.end() );
+    return {
+        stats.window.count(),
+        toSeconds(std::min(stats.window.percentile(0.50), max) ),
+        toSeconds(std::min(stats.window.percentile(0.95), max) ),
+        toSeconds(std::min(stats.window.percentile(0.99), max) ),
+        toSeconds(max),
+    };
+}
+
+LatencySummary FrameStats::totalSummary(FramePhase phase) const {
+    const auto& stats = mPhaseLst[static_cast<size_t>(phase)];
+    return {
+        stats.total.count(),
+        toSeconds(std::min(stats.total.percentile(0.50), stats.totalMax) ),
+        toSeconds(std::min(stats.total.percentile(0.95), stats.totalMax) ),
+        toSeconds(std::min(stats.total.percentile(0.99), stats.totalMax) ),
+        toSeconds(stats.totalMax),
+    };
+}
+
+void FrameStats::writeSummary(std::ostream& os) const {
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    const auto writeSummaryColumns = [&os](const LatencySummary& summary) {
+        constexpr Real msPerSecond = 1000;
+        os<<std::setw(9)<<summary.sampleCount;
+        for(const Second duration : {summary.p50, summary.p95, summary.p99, summary.max})
+            os<<std::setw(9)<<duration.value * msPerSecond;
+    };
+
+    os<<"Frame statistics in ms (last "<<windowLength<<" samples | whole run)\n";
+    os<<std::left<<std::setw(8)<<"phase"<<std::right;
+    for(int i=0; i<2; ++i)
+        os<<std::setw(9)<<"count"<<std::setw(9)<<"p50"<<std::setw(9)<<"p95"<<std::setw(9)<<"p99"<<std::setw(9)<<"max";
+    os<<'\n'<<std::fixed<<std::setprecision(3);
+    for(size_t i=0; i<framePhaseCount; ++i) {
+        const auto phase = static_cast<FramePhase>(i);
+        os<<std::left<<std::setw(8)<<toString(phase)<<std::right;
+        writeSummaryColumns(windowSummary(phase) );
+        writeSummaryColumns(totalSummary(phase) );
+        os<<'\n';
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void FrameStats::installSignalHandler() {
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, requestSummary);
+#endif // ifdef SIGUSR1
+}
+
+bool FrameStats::pollSummaryRequest() {
+    if(gIsSummaryRequested == 0)
+        return false;
+    gIsSummaryRequested = 0;
+    return true;
+}
+
+
+} // namespace Util
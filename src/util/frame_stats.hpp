@@ -0,0 +1,115 @@
+
+#ifndef HPP_UTIL_FRAME_STATS_
+#define HPP_UTIL_FRAME_STATS_
+
+#include "dimension.hpp"
+#include "typedefs.hpp"
+
+#include <array>
+#include <iosfwd>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief A histogram of durations in log-spaced buckets, like HdrHistogram
+ * @note Each power of two is split into subBucketCount linear buckets,
+ *       so a reported percentile is within ~3% of the recorded value.
+ *       It has a fixed size and never allocates
+ */
+class LatencyHistogram {
+public:
+    constexpr static unsigned subBucketBits = 5;
+    constexpr static uint64_t subBucketCount = uint64_t{1} << subBucketBits;
+    // Durations of 2^36 ns (about 68 seconds) or longer all go in the last bucket
+    constexpr static unsigned maxValueBits = 36;
+    constexpr static size_t bucketCount = (maxValueBits - subBucketBits + 1) * subBucketCount;
+
+    void add(int64_t nanoseconds);
+    void remove(int64_t nanoseconds);
+    void clear();
+
+    [[nodiscard]] uint64_t count() const;
+    /**
+     * @brief The smallest duration such that at least the given fraction of the recorded durations are not above it
+     * @param fraction - in [0, 1], e.g 0.99 for p99
+     * @return the upper bound of that duration's bucket in nanoseconds, or 0 if nothing is recorded
+     */
+    [[nodiscard]] int64_t percentile(double fraction) const;
+
+private:
+    std::array<uint32_t, bucketCount> mBucketLst{};
+    uint64_t mCount{};
+};
+
+
+enum class FramePhase : uint8_t {
+    frame,   // The whole game loop iteration
+    input,   // Handling input, summed over the ticks in the frame
+    update,  // Updating, summed over the ticks in the frame
+    draw,
+    present, // Window::display
+    tick,    // A single tick of input and update
+};
+
+inline constexpr size_t framePhaseCount = 6;
+
+[[nodiscard]] const char* toString(FramePhase phase);
+
+
+struct LatencySummary {
+    uint64_t sampleCount;
+    Second p50;
+    Second p95;
+    Second p99;
+    Second max;
+};
+
+
+/**
+ * @brief Tail latencies of each phase of the game loop
+ * @note Every phase has a histogram over the whole run and one over its last windowLength samples.
+ *       Recording is allocation-free and O(1)
+ */
+class FrameStats {
+public:
+    constexpr static size_t windowLength = 1024;
+
+    void record(FramePhase phase, Second duration);
+
+    [[nodiscard]] LatencySummary windowSummary(FramePhase phase) const;
+    [[nodiscard]] LatencySummary totalSummary(FramePhase phase) const;
+
+    /**
+     * @brief Write a table of the percentiles for the window and the whole run of every phase
+     */
+    void writeSummary(std::ostream& os) const;
+
+    /**
+     * @brief Make SIGUSR1 request a summary, where the platform has it
+     * @note The signal handler only sets a flag, the summary is written by the next pollSummaryRequest
+     */
+    static void installSignalHandler();
+    /**
+     * @return true once for every summary requested by a signal since the last call
+     */
+    [[nodiscard]] static bool pollSummaryRequest();
+
+private:
+    struct PhaseStats {
+        LatencyHistogram total;
+        LatencyHistogram window;
+        std::array<int64_t, windowLength> windowSampleLst{};
+        size_t windowIndex{};
+        int64_t totalMax{};
+    };
+
+    std::array<PhaseStats, framePhaseCount> mPhaseLst{};
+};
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_FRAME_STATS_
@@ -0,0 +1,95 @@
+
+#include "hitch_detector.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+
+namespace Util
+{
+
+
+namespace
+{
+
+
+// The state changes and anything else in the frame aren't a phase,
+// so the slowest phase is the one that took the longest out of these
+FramePhase findSlowestPhase(const FrameRecord& frame) {
+    const std::array<std::pair<FramePhase, Second>, 4> phaseTimeLst = {{
+        {FramePhase::input, frame.inputTime},
+        {FramePhase::update, frame.updateTime},
+        {FramePhase::draw, frame.drawTime},
+        {FramePhase::present, frame.presentTime},
+    }};
+    const auto slowest = std::max_element(phaseTimeLst.begin(), phaseTimeLst.end(), [](const auto& lhs, const auto& rhs){
+        return lhs.second < rhs.second;
+    });
+    return slowest->first;
+}
+
+
+} // namespace
+
+
+HitchDetector::HitchDetector(Second budget_) :
+    mBudget{budget_}
+{}
+
+bool HitchDetector::record(const FrameRecord& frame) {
+    const uint64_t frameIndex = mFrameCount++;
+    if(frame.frameTime <= mBudget)
+        return false;
+    mRecordLst[mHitchCount % recordCapacity] = {frameIndex, findSlowestPhase(frame), frame};
+    ++mHitchCount;
+    return true;
+}
+
+uint64_t HitchDetector::hitchCount() const {
+    return mHitchCount;
+}
+
+void HitchDetector::writeRecords(std::ostream& os) const {
+    constexpr Real msPerSecond = 1000;
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os<<std::fixed<<std::setprecision(3);
+    os<<"# "<<mHitchCount<<" hitches over "<<mBudget.value * msPerSecond<<" ms in "<<mFrameCount<<" frames, times are in ms\n";
+
+    const uint64_t keptCount = std::min<uint64_t>(mHitchCount, recordCapacity);
+    for(uint64_t i = mHitchCount - keptCount; i < mHitchCount; ++i) {
+        const auto& [frameIndex, slowestPhase, frame] = mRecordLst[i % recordCapacity];
+        os<<"frame="<<frameIndex
+          <<" time="<<frame.frameTime.value * msPerSecond
+          <<" slowest="<<toString(slowestPhase)
+          <<" input="<<frame.inputTime.value * msPerSecond
+          <<" update="<<frame.updateTime.value * msPerSecond
+          <<" draw="<<frame.drawTime.value * msPerSecond
+          <<" present="<<frame.presentTime.value * msPerSecond
+          <<" ticks="<<frame.tickCount
+          <<" longestTick="<<frame.longestTickTime.value * msPerSecond
+          <<" entities="<<frame.entityCount
+          <<" stateTransitions="<<frame.stateTransitionCount
+          <<" assetLoads="<<frame.assetLoadCount
+          <<" assetLoadTime="<<frame.assetLoadTime.value * msPerSecond
+          <<'\n';
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void HitchDetector::writeRecords(const std::filesystem::path& path) const {
+    std::ofstream file{path};
+    if(!file)
+        throw std::runtime_error("Can't open the hitch file: " + path.string() );
+    writeRecords(file);
+
+    if(!file)
+        throw std::runtime_error("Can't write the hitch file: " + path.string() );
+}
+
+
+} // namespace Util
@@ -0,0 +1,79 @@
+
+#ifndef HPP_UTIL_HITCH_DETECTOR_
+#define HPP_UTIL_HITCH_DETECTOR_
+
+#include "dimension.hpp"
+#include "frame_stats.hpp"
+#include "typedefs.hpp"
+
+#include <array>
+#include <filesystem>
+#include <iosfwd>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief What happened during a frame, as far as a hitch report is concerned
+ */
+struct FrameRecord {
+    Second frameTime;
+    Second inputTime;
+    Second updateTime;
+    Second drawTime;
+    Second presentTime;
+    Second longestTickTime;
+    unsigned tickCount;             // Including the catch-up ticks
+    size_t entityCount;
+    uint64_t stateTransitionCount;  // During this frame
+    uint64_t assetLoadCount;        // During this frame
+    Second assetLoadTime;
+};
+
+struct HitchRecord {
+    uint64_t frameIndex;
+    FramePhase slowestPhase;
+    FrameRecord frame;
+};
+
+
+/**
+ * @brief Keeps the latest frames that went over a time budget
+ * @note Older hitches are overwritten once recordCapacity is reached, so it never allocates
+ */
+class HitchDetector {
+public:
+    constexpr static size_t recordCapacity = 64;
+
+    explicit HitchDetector(Second budget_);
+
+    /**
+     * @brief Keep the frame if it went over the budget
+     * @return true if the frame was a hitch
+     */
+    bool record(const FrameRecord& frame);
+
+    [[nodiscard]] uint64_t hitchCount() const;
+
+    /**
+     * @brief Write a line for each hitch that is still kept, oldest first
+     */
+    void writeRecords(std::ostream& os) const;
+    /**
+     * @throws runtime_error if the file cannot be written
+     */
+    void writeRecords(const std::filesystem::path& path) const;
+
+private:
+    std::array<HitchRecord, recordCapacity> mRecordLst{};
+    uint64_t mFrameCount{};
+    uint64_t mHitchCount{};
+    Second mBudget;
+};
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_HITCH_DETECTOR_
@@ -7,6 +7,13 @@
 // Since static have multiple meanings
 #define UTIL_INTERNAL static
 
+// To mark constructors that are implicit on purpose
+#define UTIL_IMPLICIT
+
+// Concatenate after expanding the arguments, e.g to make unique names with __LINE__
+#define UTIL_CONCAT_IMPL(A, B) A##B
+#define UTIL_CONCAT(A, B) UTIL_CONCAT_IMPL(A, B)
+
 #ifdef __GNUC__
     #define UTIL_ALWAYS_INLINE inline __attribute__( (always_inline) )
 #else
@@ -0,0 +1,63 @@
+
+#include "memory_report.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+
+namespace Util
+{
+
+
+void MemoryReport::add(std::string_view subsystem, std::string_view name, uint64_t bytes) {
+    mEntryLst.push_back({std::string(subsystem), std::string(name), bytes});
+}
+
+std::span<const MemoryReport::Entry> MemoryReport::entryLst() const {
+    return mEntryLst;
+}
+
+uint64_t MemoryReport::totalBytes() const {
+    uint64_t total = 0;
+    for(const auto& entry : mEntryLst)
+        total += entry.bytes;
+    return total;
+}
+
+uint64_t MemoryReport::totalBytes(std::string_view subsystem) const {
+    uint64_t total = 0;
+    for(const auto& entry : mEntryLst) {
+        if(entry.subsystem == subsystem)
+            total += entry.bytes;
+    }
+    return total;
+}
+
+void MemoryReport::write(std::ostream& os) const {
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os<<"Memory by subsystem in KiB\n";
+    os<<std::left<<std::setw(16)<<"subsystem"<<std::setw(32)<<"name"<<std::right<<std::setw(12)<<"KiB"<<'\n';
+    const auto writeLine = [&os](std::string_view subsystem, std::string_view name, uint64_t bytes) {
+        os<<std::left<<std::setw(16)<<subsystem<<std::setw(32)<<name<<std::right<<std::fixed<<std::setprecision(1)
+          <<std::setw(12)<<static_cast<double>(bytes) / 1024<<'\n';
+    };
+    for(const auto& entry : mEntryLst)
+        writeLine(entry.subsystem, entry.name, entry.bytes);
+
+    // The totals are in the order that the subsystems were first reported
+    std::vector<std::string_view> subsystemLst;
+    for(const auto& entry : mEntryLst) {
+        if(std::find(subsystemLst.begin(), subsystemLst.end(), entry.subsystem) == subsystemLst.end() )
+            subsystemLst.push_back(entry.subsystem);
+    }
+    for(const auto subsystem : subsystemLst)
+        writeLine(subsystem, "total", totalBytes(subsystem) );
+    writeLine("all", "total", totalBytes() );
+    os.flags(flags);
+    os.precision(precision);
+}
+
+
+} // namespace Util
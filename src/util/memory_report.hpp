@@ -0,0 +1,48 @@
+
+#ifndef HPP_UTIL_MEMORYREPORT_
+#define HPP_UTIL_MEMORYREPORT_
+
+#include "typedefs.hpp"
+
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief The bytes held by each subsystem, as reported by the subsystems themselves
+ * @note Only the storage that grows with the content is counted, not the fixed size of the objects
+ */
+class MemoryReport {
+public:
+    struct Entry {
+        std::string subsystem;
+        std::string name;
+        uint64_t bytes;
+    };
+
+    void add(std::string_view subsystem, std::string_view name, uint64_t bytes);
+
+    [[nodiscard]] std::span<const Entry> entryLst() const;
+    [[nodiscard]] uint64_t totalBytes() const;
+    [[nodiscard]] uint64_t totalBytes(std::string_view subsystem) const;
+
+    /**
+     * @brief Write every entry, then the total of each subsystem
+     */
+    void write(std::ostream& os) const;
+
+private:
+    std::vector<Entry> mEntryLst{};
+};
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_MEMORYREPORT_
@@ -0,0 +1,40 @@
+
+#include "process_memory.hpp"
+
+#if defined(_WIN32)
+    #include <Windows.h>
+    #include <psapi.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <sys/resource.h>
+#endif // if defined(_WIN32)
+
+
+namespace Util
+{
+
+
+std::optional<uint64_t> peakResidentBytes() {
+#if defined(__EMSCRIPTEN__)
+    return std::nullopt;
+#elif defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if(!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters) ) )
+        return std::nullopt;
+    return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+#elif defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return std::nullopt;
+    #ifdef __APPLE__
+    // macOS gives it in bytes, other platforms in kilobytes
+    return static_cast<uint64_t>(usage.ru_maxrss);
+    #else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+    #endif // ifdef __APPLE__
+#else
+    return std::nullopt;
+#endif // if defined(__EMSCRIPTEN__)
+}
+
+
+} // namespace Util
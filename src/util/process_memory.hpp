@@ -0,0 +1,23 @@
+
+#ifndef HPP_UTIL_PROCESS_MEMORY_
+#define HPP_UTIL_PROCESS_MEMORY_
+
+#include "typedefs.hpp"
+
+#include <optional>
+
+
+namespace Util
+{
+
+
+/**
+ * @return the most physical memory that the process has used at once,
+ *         or nullopt if the platform can't tell (e.g emscripten)
+ */
+[[nodiscard]] std::optional<uint64_t> peakResidentBytes();
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_PROCESS_MEMORY_
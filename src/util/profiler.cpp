@@ -0,0 +1,214 @@
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace Util
+{
+
+
+namespace
+{
+
+
+// Each thread keeps its latest zones, older ones are overwritten
+constexpr size_t zoneCapacity = size_t{1} << 16;
+constexpr size_t zoneMask = zoneCapacity - 1;
+
+// The fields are atomic so that exporting can read them while the thread is recording
+struct ZoneRecord {
+    std::atomic<const char*> name;
+    std::atomic<int64_t> startNs;
+    std::atomic<int64_t> durationNs;
+};
+
+struct ZoneCopy {
+    const char* name;
+    int64_t startNs;
+    int64_t durationNs;
+};
+
+/**
+ * @brief A single-producer ring buffer that is written by its own thread without locking
+ * @note Works like a seqlock: mWriteBegin is bumped before a record is written and mWriteEnd after,
+ *       so a reader can tell which records could have been overwritten while it was copying them
+ */
+class ZoneRingBuffer {
+public:
+    explicit ZoneRingBuffer(uint64_t threadId_) :
+        mThreadId{threadId_}
+    {}
+
+    void push(const char* name, int64_t startNs, int64_t durationNs) noexcept {
+        const uint64_t index = mWriteEnd.load(std::memory_order_relaxed);
+        mWriteBegin.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        ZoneRecord& record = mRecordLst[index & zoneMask];
+        record.name.store(name, std::memory_order_relaxed);
+        record.startNs.store(startNs, std::memory_order_relaxed);
+        record.durationNs.store(durationNs, std::memory_order_relaxed);
+        mWriteEnd.store(index + 1, std::memory_order_release);
+    }
+
+    void copyTo(std::vector<ZoneCopy>& zoneLst) const {
+        const uint64_t end = mWriteEnd.load(std::memory_order_acquire);
+        const uint64_t begin = end > zoneCapacity ? end - zoneCapacity : 0;
+        const size_t firstCopy = zoneLst.size();
+        for(uint64_t index = begin; index < end; ++index) {
+            const ZoneRecord& record = mRecordLst[index & zoneMask];
+            zoneLst.push_back({
+                record.name.load(std::memory_order_relaxed),
+                record.startNs.load(std::memory_order_relaxed),
+                record.durationNs.load(std::memory_order_relaxed),
+            });
+        }
+        // Discard the records that the thread could have started overwriting during the copy
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t writeBegin = mWriteBegin.load(std::memory_order_relaxed);
+        const uint64_t validBegin = writeBegin > zoneCapacity ? writeBegin - zoneCapacity : 0;
+        const auto discardCount = static_cast<ptrdiff_t>(std::min(std::max(validBegin, begin) - begin, end - begin) );
+        const auto firstIter = zoneLst.begin() + static_cast<ptrdiff_t>(firstCopy);
+        zoneLst.erase(firstIter, firstIter + discardCount);
+    }
+
+    [[nodiscard]] uint64_t threadId() const {
+        return mThreadId;
+    }
+
+    void setName(const char* name) {
+        mName.store(name, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] const char* name() const {
+        return mName.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<ZoneRecord, zoneCapacity> mRecordLst{};
+    std::atomic<uint64_t> mWriteBegin{};
+    std::atomic<uint64_t> mWriteEnd{};
+    std::atomic<const char*> mName{nullptr};
+    uint64_t mThreadId;
+};
+
+
+// Buffers are kept until exit, so the zones of threads that have finished can still be exported
+struct BufferRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ZoneRingBuffer> > bufferLst;
+};
+
+BufferRegistry& getRegistry() {
+    static BufferRegistry sRegistry;
+    return sRegistry;
+}
+
+ZoneRingBuffer& getThreadBuffer() {
+    thread_local ZoneRingBuffer* tBuffer = []{
+        auto& registry = getRegistry();
+        std::lock_guard lock{registry.mutex};
+        const uint64_t threadId = registry.bufferLst.size() + 1;
+        registry.bufferLst.push_back(std::make_unique<ZoneRingBuffer>(threadId) );
+        return registry.bufferLst.back().get();
+    }();
+    return *tBuffer;
+}
+
+int64_t nowNs() noexcept {
+    using namespace std::chrono;
+    static const auto sEpoch = steady_clock::now();
+    return duration_cast<nanoseconds>(steady_clock::now() - sEpoch).count();
+}
+
+void writeJsonString(std::ostream& os, const char* str) {
+    os<<'"';
+    for(; *str != '\0'; ++str) {
+        if(*str == '"' || *str == '\\')
+            os<<'\\';
+        os<<*str;
+    }
+    os<<'"';
+}
+
+
+} // namespace
+
+
+ProfileZone::ProfileZone(const char* name_) noexcept :
+    mName{name_},
+    mStartNs{nowNs()}
+{}
+
+ProfileZone::~ProfileZone() {
+    getThreadBuffer().push(mName, mStartNs, nowNs() - mStartNs);
+}
+
+
+namespace Profiler
+{
+
+
+void setThreadName(const char* name) {
+    getThreadBuffer().setName(name);
+}
+
+void exportChromeTrace(const std::filesystem::path& path) {
+    std::ofstream file{path};
+    if(!file)
+        throw std::runtime_error("Can't open the trace file: " + path.string() );
+
+    // Timestamps are in microseconds
+    file<<std::fixed;
+    file.precision(3);
+    file<<"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool isFirst = true;
+    const auto separate = [&]{
+        if(!isFirst)
+            file<<",\n";
+        isFirst = false;
+    };
+
+    auto& registry = getRegistry();
+    std::lock_guard lock{registry.mutex};
+    std::vector<ZoneCopy> zoneLst;
+    for(const auto& buffer : registry.bufferLst) {
+        const uint64_t threadId = buffer->threadId();
+        if(const char* threadName = buffer->name() ) {
+            separate();
+            file<<"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"<<threadId<<",\"args\":{\"name\":";
+            writeJsonString(file, threadName);
+            file<<"}}";
+        }
+
+        zoneLst.clear();
+        buffer->copyTo(zoneLst);
+        for(const auto& zone : zoneLst) {
+            separate();
+            file<<"{\"name\":";
+            writeJsonString(file, zone.name);
+            file<<",\"ph\":\"X\",\"pid\":1,\"tid\":"<<threadId
+                <<",\"ts\":"<<static_cast<double>(zone.startNs) / 1000.0
+                <<",\"dur\":"<<static_cast<double>(zone.durationNs) / 1000.0<<"}";
+        }
+    }
+    file<<"\n]}\n";
+
+    if(!file)
+        throw std::runtime_error("Can't write the trace file: " + path.string() );
+}
+
+
+} // namespace Profiler
+
+
+} // namespace Util
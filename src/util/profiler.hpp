@@ -0,0 +1,69 @@
+
+#ifndef HPP_UTIL_PROFILER_
+#define HPP_UTIL_PROFILER_
+
+#include "macros.hpp"
+#include "typedefs.hpp"
+
+#include <filesystem>
+
+
+/**
+ * UTIL_PROFILE_ZONE(name) times the rest of the enclosing scope as a zone with that name
+ * The name must be a string literal (or have static storage duration)
+ * Zones are only recorded if UTIL_ENABLE_PROFILER is defined, otherwise they compile to nothing
+ * @example void update() { UTIL_PROFILE_ZONE("update"); ... }
+ */
+/*NO-FORMAT*/
+#ifdef UTIL_ENABLE_PROFILER
+    #define UTIL_PROFILE_ZONE(NAME) const ::Util::ProfileZone UTIL_CONCAT(utilProfileZone_, __LINE__){NAME}
+#else
+    #define UTIL_PROFILE_ZONE(NAME) do{}while(false)
+#endif // ifdef UTIL_ENABLE_PROFILER
+/*YES-FORMAT*/
+
+
+namespace Util
+{
+
+
+/**
+ * @brief Records the time from its construction to its destruction in the calling thread's ring buffer
+ * @note Use UTIL_PROFILE_ZONE instead, so that it can be compiled out
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name_) noexcept;
+    ~ProfileZone();
+    ProfileZone& operator=(ProfileZone&&) = delete; // no copy nor move
+
+private:
+    const char* mName;
+    int64_t mStartNs;
+};
+
+
+namespace Profiler
+{
+
+
+/**
+ * @brief Name the calling thread in the exported trace
+ * @note The name must be a string literal (or have static storage duration)
+ */
+void setThreadName(const char* name);
+
+/**
+ * @brief Write the zones that are still in every thread's ring buffer as Chrome trace event JSON
+ * @note Can be opened with chrome://tracing or https://ui.perfetto.dev
+ * @throws runtime_error if the file cannot be written
+ */
+void exportChromeTrace(const std::filesystem::path& path);
+
+
+} // namespace Profiler
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_PROFILER_
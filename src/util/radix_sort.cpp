@@ -0,0 +1,54 @@
+
+#include "radix_sort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <utility>
+
+
+namespace Util
+{
+
+
+void radixSort(std::span<uint64_t> keys, std::span<uint64_t> scratch, unsigned orderedLowBytes) {
+    assert(scratch.size() >= keys.size() && "radixSort needs a large enough scratch buffer");
+    assert(orderedLowBytes <= sizeof(uint64_t) );
+    constexpr unsigned byteCount = sizeof(uint64_t);
+    const size_t keyCount = keys.size();
+    if(keyCount < 2)
+        return;
+
+    // Obtain the histograms for every byte in a single read
+    std::array<std::array<size_t, 256>, byteCount> histogramLst{};
+    for(const uint64_t key : keys) {
+        for(unsigned byte = orderedLowBytes; byte < byteCount; ++byte)
+            ++histogramLst[byte][(key >> (byte * 8) ) & 0xFF];
+    }
+
+    std::span<uint64_t> src = keys;
+    std::span<uint64_t> dest = scratch.first(keyCount);
+    for(unsigned byte = orderedLowBytes; byte < byteCount; ++byte) {
+        auto& histogram = histogramLst[byte];
+        // Every key has the same byte, so this pass wouldn't change the order
+        if(std::ranges::find(histogram, keyCount) != histogram.end() )
+            continue;
+
+        // Turn the histogram into the starting offset for each bucket
+        size_t offset = 0;
+        for(auto& count : histogram)
+            offset += std::exchange(count, offset);
+
+        const unsigned shift = byte * 8;
+        for(const uint64_t key : src)
+            dest[histogram[(key >> shift) & 0xFF]++] = key;
+        std::swap(src, dest);
+    }
+
+    // The sorted keys may have ended up in the scratch buffer
+    if(src.data() != keys.data() )
+        std::ranges::copy(src, keys.begin() );
+}
+
+
+} // namespace Util
@@ -0,0 +1,26 @@
+
+#ifndef HPP_UTIL_RADIXSORT_
+#define HPP_UTIL_RADIXSORT_
+
+#include "typedefs.hpp"
+
+#include <span>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief Stable least-significant-digit radix sort of 64-bit keys, one byte per pass
+ * @param keys - the keys to be sorted, the result is also stored here
+ * @param scratch - a buffer with at least as many elements as keys
+ * @param orderedLowBytes - the number of low bytes that are already in ascending order (e.g. a sequence number)
+ * @note Passes where every key has the same byte are skipped, so it's usually much less than 8 passes
+ */
+void radixSort(std::span<uint64_t> keys, std::span<uint64_t> scratch, unsigned orderedLowBytes = 0);
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_RADIXSORT_
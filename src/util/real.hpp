@@ -2,18 +2,28 @@
 #ifndef HPP_UTIL_REAL_1657306623_
 #define HPP_UTIL_REAL_1657306623_
 
+#include "fixed.hpp"
 #include "macros.hpp"
 
 #include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <type_traits>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define UTIL_REAL_SSE 1
+    #include <xmmintrin.h>
+#endif // if SSE is available
+
 
 namespace Util
 {
 
 
+// REAL_TYPE can be a fixed-point type (e.g. Util::Q32_32) for a bit-deterministic simulation
 #ifdef REAL_TYPE
 using Real = REAL_TYPE;
 #else
@@ -74,6 +84,29 @@ bool nearly_equal(T lhs, T rhs, T eps = std::numeric_limits<T>::epsilon() ) {
 }
 
 
+/**
+ * @brief An approximate 1/sqrt(x) for positive normal floats, with a relative error below 1e-5
+ * @note An SSE estimate refined by one Newton-Raphson step (about 3e-7 error),
+ *       or a bit trick refined by two without SSE (about 5e-6), other types use the exact 1/sqrt(x)
+ */
+template<typename T> inline
+T fastRsqrt(T x) noexcept {
+    if constexpr(std::is_same_v<T, float>) {
+#ifdef UTIL_REAL_SSE
+        const float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x) ) );
+#else
+        // The bit trick is only good to 3%, so it needs a second step
+        float estimate = std::bit_cast<float>(0x5F375A86u - (std::bit_cast<uint32_t>(x) >> 1) );
+        estimate *= 1.5f - 0.5f * x * estimate * estimate;
+#endif // ifdef UTIL_REAL_SSE
+        return estimate * (1.5f - 0.5f * x * estimate * estimate);
+    } else {
+        using std::sqrt;
+        return T{1} / sqrt(x);
+    }
+}
+
+
 } // namespace Util
 
 #endif  // HPP_UTIL_REAL_1657306623_
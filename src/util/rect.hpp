@@ -6,6 +6,7 @@
 #include "vec2.hpp"
 
 #include <cassert>
+#include <type_traits>
 
 
 namespace Util
@@ -35,7 +36,7 @@ public:
             max(thisCorner_.x, thatCorner_.x),
             max(thisCorner_.y, thatCorner_.y),
         };
-        const Displacement<T, R> halfExtent_ = (rightBottom_ - leftTop_) * 0.5_r;
+        const Displacement<T, R> halfExtent_ = (rightBottom_ - leftTop_) * T{0.5};
         return Rect{leftTop_ + halfExtent_, halfExtent_};
     }
 
@@ -44,8 +45,9 @@ public:
      */
     [[nodiscard]] static constexpr Rect centreSize(Position<T, R> centre_, Displacement<T, R> size_)
     {
-        assert("Rectangle size must be positive: " && size_.x >= 0_bl && size_.y >= 0_bl);
-        const Displacement<T, R> halfExtent_ = size_ * 0.5_r;
+        [[maybe_unused]] constexpr auto zero = Distance<T, R>::zero();
+        assert("Rectangle size must be positive: " && size_.x >= zero && size_.y >= zero);
+        const Displacement<T, R> halfExtent_ = size_ * T{0.5};
         return Rect{centre_, halfExtent_};
     }
 
@@ -54,7 +56,7 @@ public:
      */
     [[nodiscard]] static constexpr Rect leftTopSize(Position<T, R> leftTop_, Displacement<T, R> size_)
     {
-        const Displacement<T, R> halfExtent_ = size_ * 0.5_r;
+        const Displacement<T, R> halfExtent_ = size_ * T{0.5};
         return Rect{leftTop_ + halfExtent_, halfExtent_};
     }
 
@@ -63,7 +65,7 @@ public:
      */
     [[nodiscard]] static constexpr Rect rightBottomSize(Position<T, R> rightBottom_, Displacement<T, R> size_)
     {
-        const Displacement<T, R> halfExtent_ = size_ * 0.5_r;
+        const Displacement<T, R> halfExtent_ = size_ * T{0.5};
         return Rect{rightBottom_ - halfExtent_, halfExtent_};
     }
 
@@ -72,7 +74,7 @@ public:
      */
     [[nodiscard]] static constexpr Rect leftBottomSize(Position<T, R> leftBottom_, Displacement<T, R> size_)
     {
-        const Displacement<T, R> halfExtent_ = size_ * 0.5_r;
+        const Displacement<T, R> halfExtent_ = size_ * T{0.5};
         const Position<T, R> centre_ = {leftBottom_.x + halfExtent_.x, leftBottom_.y - halfExtent_.y};
         return Rect{centre_, halfExtent_};
     }
@@ -82,7 +84,7 @@ public:
      */
     [[nodiscard]] static constexpr Rect rightTopSize(Position<T, R> rightTop_, Displacement<T, R> size_)
     {
-        const Displacement<T, R> halfExtent_ = size_ * 0.5_r;
+        const Displacement<T, R> halfExtent_ = size_ * T{0.5};
         const Position<T, R> centre_ = {rightTop_.x - halfExtent_.x, rightTop_.y + halfExtent_.y};
         return Rect{centre_, halfExtent_};
     }
@@ -181,28 +183,28 @@ public:
      * @brief Get the rectangle's dimensions
      */
     [[nodiscard]] constexpr Displacement<T, R> size() const {
-        return mHalfExtent * 2_r;
+        return mHalfExtent * T{2};
     }
 
     /**
      * @brief Get the rectangle's area
      */
     [[nodiscard]] constexpr Area<T, R> area() const {
-        return mHalfExtent.x * mHalfExtent.y * 4_r;
+        return mHalfExtent.x * mHalfExtent.y * T{4};
     }
 
     /**
      * @brief Get the rectangle's width
      */
     [[nodiscard]] constexpr Distance<T, R> width() const {
-        return mHalfExtent.x * 2_r;
+        return mHalfExtent.x * T{2};
     }
 
     /**
      * @brief Get the rectangle's height
      */
     [[nodiscard]] constexpr Distance<T, R> height() const {
-        return mHalfExtent.y * 2_r;
+        return mHalfExtent.y * T{2};
     }
 
 
@@ -288,7 +290,7 @@ public:
      */
     constexpr void setLeftTop(Position<T, R> newLeftTop_) {
         const auto rightBottom_ = rightBottom();
-        mHalfExtent = 0.5_r * (rightBottom_ - newLeftTop_);
+        mHalfExtent = T{0.5} * (rightBottom_ - newLeftTop_);
         mCentre = newLeftTop_ + mHalfExtent;
     }
 
@@ -298,7 +300,7 @@ public:
      */
     [[nodiscard]] constexpr Rect withLeftTopAs(Position<T, R> newLeftTop_) const {
         const auto rightBottom_ = rightBottom();
-        const auto halfExtent_ = 0.5_r * (rightBottom_ - newLeftTop_);
+        const auto halfExtent_ = T{0.5} * (rightBottom_ - newLeftTop_);
         const auto centre_ = newLeftTop_ + halfExtent_;
         return Rect{centre_, halfExtent_};
     }
@@ -327,7 +329,7 @@ public:
      */
     constexpr void setRightTop(Position<T, R> newRightTop_) {
         const auto leftBottom_ = leftBottom();
-        mHalfExtent = 0.5_r * Displacement<T, R>{
+        mHalfExtent = T{0.5} * Displacement<T, R>{
             newRightTop_.x - leftBottom_.x,
             leftBottom_.y - newRightTop_.y,
         };
@@ -343,7 +345,7 @@ public:
      */
     [[nodiscard]] constexpr Rect withRightTopAs(Position<T, R> newRightTop_) const {
         const auto leftBottom_ = leftBottom();
-        const auto halfExtent_ = 0.5_r * Displacement<T, R>{
+        const auto halfExtent_ = T{0.5} * Displacement<T, R>{
             newRightTop_.x - leftBottom_.x,
             leftBottom_.y - newRightTop_.y,
         };
@@ -378,7 +380,7 @@ public:
      */
     constexpr void setLeftBottom(Position<T, R> newLeftBottom_) {
         const auto rightTop_ = rightTop();
-        mHalfExtent = 0.5_r * Displacement<T, R>{
+        mHalfExtent = T{0.5} * Displacement<T, R>{
             rightTop_.x - newLeftBottom_.x,
             newLeftBottom_.y - rightTop_.y,
         };
@@ -394,7 +396,7 @@ public:
      */
     [[nodiscard]] constexpr Rect withLeftBottomAs(Position<T, R> newLeftBottom_) const {
         const auto rightTop_ = rightTop();
-        const auto halfExtent_ = 0.5_r * Displacement<T, R>{
+        const auto halfExtent_ = T{0.5} * Displacement<T, R>{
             rightTop_.x - newLeftBottom_.x,
             newLeftBottom_.y - rightTop_.y,
         };
@@ -429,7 +431,7 @@ public:
      */
     constexpr void setRightBottom(Position<T, R> newRightBottom_) {
         const auto leftTop_ = leftTop();
-        mHalfExtent = 0.5_r * (newRightBottom_ - leftTop_);
+        mHalfExtent = T{0.5} * (newRightBottom_ - leftTop_);
         mCentre = newRightBottom_ - mHalfExtent;
     }
 
@@ -439,7 +441,7 @@ public:
      */
     [[nodiscard]] constexpr Rect withRightBottomAs(Position<T, R> newRightBottom_) const {
         const auto leftTop_ = leftTop();
-        const auto halfExtent_ = 0.5_r * (newRightBottom_ - leftTop_);
+        const auto halfExtent_ = T{0.5} * (newRightBottom_ - leftTop_);
         const auto centre_ = newRightBottom_ - halfExtent_;
         return Rect{centre_, halfExtent_};
     }
@@ -467,7 +469,7 @@ public:
      * @note The right edge will not change
      */
     constexpr void setLeft(PositionScalar<T, R> newLeft_) {
-        mHalfExtent.x = 0.5_r * (right() - newLeft_);
+        mHalfExtent.x = T{0.5} * (right() - newLeft_);
         mCentre.x = newLeft_ + mHalfExtent.x;
     }
 
@@ -477,7 +479,7 @@ public:
      */
     [[nodiscard]] constexpr Rect withLeftAs(PositionScalar<T, R> newLeft_) const {
         const Displacement<T, R> newHalfExtent = {
-            0.5_r * (right() - newLeft_),
+            T{0.5} * (right() - newLeft_),
             mHalfExtent.y,
         };
         const Position<T, R> newCentre = {
@@ -510,7 +512,7 @@ public:
      * @note The left edge will not change
      */
     constexpr void setRight(PositionScalar<T, R> newRight_) {
-        mHalfExtent.x = 0.5_r * (newRight_ - left() );
+        mHalfExtent.x = T{0.5} * (newRight_ - left() );
         mCentre.x = newRight_ - mHalfExtent.x;
     }
 
@@ -520,7 +522,7 @@ public:
      */
     [[nodiscard]] constexpr Rect withRightAs(PositionScalar<T, R> newRight_) const {
         const Displacement<T, R> newHalfExtent = {
-            0.5_r * (newRight_ - left() ),
+            T{0.5} * (newRight_ - left() ),
             mHalfExtent.y,
         };
         const Position<T, R> newCentre = {
@@ -553,7 +555,7 @@ public:
      * @note The bottom edge will not change
      */
     constexpr void setTop(PositionScalar<T, R> newTop_) {
-        mHalfExtent.y = 0.5_r * (bottom() - newTop_);
+        mHalfExtent.y = T{0.5} * (bottom() - newTop_);
         mCentre.y = newTop_ + mHalfExtent.y;
     }
 
@@ -564,7 +566,7 @@ public:
     [[nodiscard]] constexpr Rect withTopAs(PositionScalar<T, R> newTop_) const {
         const Displacement<T, R> newHalfExtent = {
             mHalfExtent.x,
-            0.5_r * (bottom() - newTop_),
+            T{0.5} * (bottom() - newTop_),
         };
         const Position<T, R> newCentre = {
             mCentre.x,
@@ -596,7 +598,7 @@ public:
      * @note The top edge will not change
      */
     constexpr void setBottom(PositionScalar<T, R> newBottom_) {
-        mHalfExtent.y = 0.5_r * (newBottom_ - top() );
+        mHalfExtent.y = T{0.5} * (newBottom_ - top() );
         mCentre.y = newBottom_ - mHalfExtent.y;
     }
 
@@ -607,7 +609,7 @@ public:
     [[nodiscard]] constexpr Rect withBottomAs(PositionScalar<T, R> newBottom_) const {
         const Displacement<T, R> newHalfExtent = {
             mHalfExtent.x,
-            0.5_r * (newBottom_ - top() ),
+            T{0.5} * (newBottom_ - top() ),
         };
         const Position<T, R> newCentre = {
             mCentre.x,
@@ -622,14 +624,14 @@ public:
     /**
      * @brief Change the rect's size by the specified scale factor with its centre as the scale origin
      */
-    constexpr void scaleThis(Real scaleFactor) {
+    constexpr void scaleThis(T scaleFactor) {
         mHalfExtent *= scaleFactor;
     }
 
     /**
      * @brief Change the rect's size by the specified scale factor and scale origin
      */
-    constexpr void scaleThis(Real scaleFactor, Position<T, R> scaleOrigin) {
+    constexpr void scaleThis(T scaleFactor, Position<T, R> scaleOrigin) {
         const auto scaleOriginToCentre = mCentre - scaleOrigin;
         const auto newScaleOriginToCentre = scaleOriginToCentre * scaleFactor;
         mHalfExtent *= scaleFactor;
@@ -639,14 +641,14 @@ public:
     /**
      * @brief Obtain a rect with a size that's scaled by the specified scale factor with its centre as the scale origin
      */
-    [[nodiscard]] constexpr Rect withScaled(Real scaleFactor) const {
+    [[nodiscard]] constexpr Rect withScaled(T scaleFactor) const {
         return Rect{mCentre, mHalfExtent* scaleFactor};
     }
 
     /**
      * @brief Obtain a rect with a scaled size by the specified scale factor and scale origin
      */
-    [[nodiscard]] constexpr Rect withScaled(Real scaleFactor, Position<T, R> scaleOrigin) const {
+    [[nodiscard]] constexpr Rect withScaled(T scaleFactor, Position<T, R> scaleOrigin) const {
         const auto scaleOriginToCentre = mCentre - scaleOrigin;
         const auto newScaleOriginToCentre = scaleOriginToCentre * scaleFactor;
         const auto halfExtent_ = mHalfExtent * scaleFactor;
@@ -657,14 +659,14 @@ public:
     /**
      * @brief Change the rect's width by the specified scale factor with its centre as the scale origin
      */
-    constexpr void scaleThisWidth(Real scaleFactor) {
+    constexpr void scaleThisWidth(T scaleFactor) {
         mHalfExtent.x *= scaleFactor;
     }
 
     /**
      * @brief Change the rect's width by the specified scale factor and horizontal scale origin
      */
-    constexpr void scaleThisWidth(Real scaleFactor, PositionScalar<T, R> scaleOriginX) {
+    constexpr void scaleThisWidth(T scaleFactor, PositionScalar<T, R> scaleOriginX) {
         const auto scaleOriginToCentreX = mCentre.x - scaleOriginX;
         const auto newScaleOriginToCentreX = scaleOriginToCentreX * scaleFactor;
         mHalfExtent.x *= scaleFactor;
@@ -674,14 +676,14 @@ public:
     /**
      * @brief Obtain a rect with a width that's scaled by the specified scale factor with its centre as the scale origin
      */
-    [[nodiscard]] constexpr Rect withScaledWidth(Real scaleFactor) const {
+    [[nodiscard]] constexpr Rect withScaledWidth(T scaleFactor) const {
         return Rect{mCentre, {mHalfExtent.x* scaleFactor, mHalfExtent.y} };
     }
 
     /**
      * @brief Obtain a rect with a scaled width by the specified scale factor and horizontal scale origin
      */
-    [[nodiscard]] constexpr Rect withScaledWidth(Real scaleFactor, PositionScalar<T, R> scaleOriginX) const
+    [[nodiscard]] constexpr Rect withScaledWidth(T scaleFactor, PositionScalar<T, R> scaleOriginX) const
     {
         const auto scaleOriginToCentreX = mCentre.x - scaleOriginX;
         const auto newScaleOriginToCentreX = scaleOriginToCentreX * scaleFactor;
@@ -699,14 +701,14 @@ public:
     /**
      * @brief Change the rect's height by the specified scale factor with its centre as the scale origin
      */
-    constexpr void scaleThisHeight(Real scaleFactor) {
+    constexpr void scaleThisHeight(T scaleFactor) {
         mHalfExtent.y *= scaleFactor;
     }
 
     /**
      * @brief Change the rect's height by the specified scale factor and vertical scale origin
      */
-    constexpr void scaleThisHeight(Real scaleFactor, PositionScalar<T, R> scaleOriginY) {
+    constexpr void scaleThisHeight(T scaleFactor, PositionScalar<T, R> scaleOriginY) {
         const auto scaleOriginToCentreY = mCentre.y - scaleOriginY;
         const auto newScaleOriginToCentreY = scaleOriginToCentreY * scaleFactor;
         mHalfExtent.y *= scaleFactor;
@@ -716,14 +718,14 @@ public:
     /**
      * @brief Obtain a rect with a height that's scaled by the specified scale factor with its centre as the scale origin
      */
-    [[nodiscard]] constexpr Rect withScaledHeight(Real scaleFactor) const {
+    [[nodiscard]] constexpr Rect withScaledHeight(T scaleFactor) const {
         return Rect{mCentre, {mHalfExtent.x, mHalfExtent.y * scaleFactor} };
     }
 
     /**
      * @brief Obtain a rect with a scaled height by the specified scale factor and vertical scale origin
      */
-    [[nodiscard]] constexpr Rect withScaledHeight(Real scaleFactor, PositionScalar<T, R> scaleOriginY) const
+    [[nodiscard]] constexpr Rect withScaledHeight(T scaleFactor, PositionScalar<T, R> scaleOriginY) const
     {
         const auto scaleOriginToCentreY = mCentre.y - scaleOriginY;
         const auto newScaleOriginToCentreY = scaleOriginToCentreY * scaleFactor;
@@ -741,7 +743,7 @@ public:
     /**
      * @brief Change the rect's width and height by the specified scale factor with its centre as the scale origin
      */
-    constexpr void scaleThisBoth(Vec2<Real> scaleFactor) {
+    constexpr void scaleThisBoth(Vec2<T> scaleFactor) {
         scaleThisWidth(scaleFactor.x);
         scaleThisHeight(scaleFactor.y);
     }
@@ -749,7 +751,7 @@ public:
     /**
      * @brief Change the rect's width and height by the specified scale factor and scale origin
      */
-    constexpr void scaleThisBoth(Vec2<Real> scaleFactor, Position<T, R> scaleOrigin) {
+    constexpr void scaleThisBoth(Vec2<T> scaleFactor, Position<T, R> scaleOrigin) {
         scaleThisWidth(scaleFactor.x, scaleOrigin.x);
         scaleThisHeight(scaleFactor.y, scaleOrigin.y);
     }
@@ -757,14 +759,14 @@ public:
     /**
      * @brief Obtain a rect with a width and height that's scaled by the specified scale factor with its centre as the scale origin
      */
-    [[nodiscard]] constexpr Rect withScaledBoth(Vec2<Real> scaleFactor) const {
+    [[nodiscard]] constexpr Rect withScaledBoth(Vec2<T> scaleFactor) const {
         return withScaledWidth(scaleFactor.x).withScaledHeight(scaleFactor.y);
     }
 
     /**
      * @brief Obtain a rect with a scaled width and height by the specified scale factor and vertical scale origin
      */
-    [[nodiscard]] constexpr Rect withScaledBoth(Vec2<Real> scaleFactor, Position<T, R> scaleOrigin) const
+    [[nodiscard]] constexpr Rect withScaledBoth(Vec2<T> scaleFactor, Position<T, R> scaleOrigin) const
     {
         return withScaledWidth(scaleFactor.x, scaleOrigin.x).withScaledHeight(scaleFactor.y, scaleOrigin.y);
     }
@@ -776,7 +778,7 @@ public:
      * @brief Change the rect's size to specified length with its centre as the scale origin
      */
     constexpr void setSize(Distance<T, R> newLength) {
-        const auto halfNewLength = 0.5_r * newLength;
+        const auto halfNewLength = T{0.5} * newLength;
         mHalfExtent = {halfNewLength, halfNewLength};
     }
 
@@ -784,7 +786,7 @@ public:
      * @brief Obtain a rect with the specified length and with its centre as the scale origin
      */
     constexpr Rect withSize(Distance<T, R> newLength) const {
-        const auto halfNewLength = 0.5_r * newLength;
+        const auto halfNewLength = T{0.5} * newLength;
         return Rect{mCentre, {halfNewLength, halfNewLength} };
     }
 
@@ -792,7 +794,7 @@ public:
      * @brief Change the rect's width to specified length with its centre as the scale origin
      */
     constexpr void setWidth(Distance<T, R> newWidth) {
-        mHalfExtent.x = 0.5_r * newWidth;
+        mHalfExtent.x = T{0.5} * newWidth;
     }
 
     /**
@@ -801,7 +803,7 @@ public:
     constexpr Rect withWidth(Distance<T, R> newWidth) const {
         return Rect{
             mCentre,
-            {0.5_r * newWidth, mHalfExtent.y}
+            {T{0.5} * newWidth, mHalfExtent.y}
         };
     }
 
@@ -809,7 +811,7 @@ public:
      * @brief Change the rect's height to specified length with its centre as the scale origin
      */
     constexpr void setHeight(Distance<T, R> newHeight) {
-        mHalfExtent.y = 0.5_r * newHeight;
+        mHalfExtent.y = T{0.5} * newHeight;
     }
 
     /**
@@ -818,7 +820,7 @@ public:
     constexpr Rect withHeight(Distance<T, R> newHeight) const {
         return Rect{
             mCentre,
-            {mHalfExtent.x, 0.5_r * newHeight},
+            {mHalfExtent.x, T{0.5} * newHeight},
         };
     }
 
@@ -826,14 +828,14 @@ public:
      * @brief Change the rect's size to specified size with its centre as the scale origin
      */
     constexpr void setSize(Displacement<T, R> newSize) {
-        mHalfExtent = 0.5_r * newSize;
+        mHalfExtent = T{0.5} * newSize;
     }
 
     /**
      * @brief Obtain a rect with the specified size and with its centre as the scale origin
      */
     constexpr Rect withSize(Displacement<T, R> newSize) const {
-        return Rect{mCentre, 0.5_r * newSize};
+        return Rect{mCentre, T{0.5} * newSize};
     }
 
 
@@ -855,7 +857,7 @@ public:
      * @note Rectangles should be valid for non-trivial operations
      */
     [[nodiscard]] constexpr bool isValid() const noexcept {
-        return mHalfExtent.x >= 0_bl && mHalfExtent.y >= 0_bl;
+        return mHalfExtent.x >= Distance<T, R>::zero() && mHalfExtent.y >= Distance<T, R>::zero();
     }
 
     /**
@@ -870,12 +872,13 @@ public:
      * @note Rectangles should be valid for non-trivial operations
      */
     constexpr void makeValid() {
-        mHalfExtent.x = mHalfExtent.x > 0_bl ? mHalfExtent.x :
-                    mHalfExtent.x < 0_bl ? -mHalfExtent.x :
-                        0_bl;
-        mHalfExtent.y = mHalfExtent.y > 0_bl ? mHalfExtent.y :
-                    mHalfExtent.y < 0_bl ? -mHalfExtent.y :
-                        0_bl;
+        constexpr auto zero = Distance<T, R>::zero();
+        mHalfExtent.x = mHalfExtent.x > zero ? mHalfExtent.x :
+                    mHalfExtent.x < zero ? -mHalfExtent.x :
+                        zero;
+        mHalfExtent.y = mHalfExtent.y > zero ? mHalfExtent.y :
+                    mHalfExtent.y < zero ? -mHalfExtent.y :
+                        zero;
     }
 
     [[nodiscard]] constexpr friend bool operator==(const Rect<T, R>& lhs, const Rect<T, R>& rhs) {
@@ -935,6 +938,22 @@ template<typename T, typename R>
 }
 
 
+/**
+ * @brief Obtain the smallest rectangle that contains both rectangles
+ * @param lhs - One of the valid rectangles to be contained (must be valid)
+ * @param rhs - One of the valid rectangles to be contained (must be valid)
+ */
+template<typename T, typename R>
+[[nodiscard]] constexpr Rect<T, R> boundingRect(const Rect<T, R>& lhs, const Rect<T, R>& rhs) {
+    assert(lhs.isValid() && rhs.isValid() && "boundingRect needs both rects to be valid");
+    const auto left =   min(lhs.left(), rhs.left() );
+    const auto right =  max(lhs.right(), rhs.right() );
+    const auto top  =   min(lhs.top(), rhs.top() );
+    const auto bottom = max(lhs.bottom(), rhs.bottom() );
+    return Rect<T, R>::cornerCorner({left, top}, {right, bottom});
+}
+
+
 // [SECTION]: Operators
 
 template<typename T, typename R>
@@ -957,19 +976,20 @@ inline Rect<T, R> operator-(Displacement<T, R> dis, const Rect<T, R>& rect) {
     return rect.movedBy(-dis);
 }
 
+// The scale factor isn't deduced, so that it can be any number that converts to T, e.g. rect * 2
 template<typename T, typename R>
-inline Rect<T, R> operator*(const Rect<T, R>& rect, Real scaleFactor) {
+inline Rect<T, R> operator*(const Rect<T, R>& rect, std::type_identity_t<T> scaleFactor) {
     return rect.withScaled(scaleFactor);
 }
 
 template<typename T, typename R>
-inline Rect<T, R> operator*(Real scaleFactor, const Rect<T, R>& rect) {
+inline Rect<T, R> operator*(std::type_identity_t<T> scaleFactor, const Rect<T, R>& rect) {
     return rect.withScaled(scaleFactor);
 }
 
 template<typename T, typename R>
-inline Rect<T, R> operator/(const Rect<T, R>& rect, Real scaleFactor) {
-    return rect.withScaled(1_r / scaleFactor);
+inline Rect<T, R> operator/(const Rect<T, R>& rect, std::type_identity_t<T> scaleFactor) {
+    return rect.withScaled(T{1} / scaleFactor);
 }
 
 /**
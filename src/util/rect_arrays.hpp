@@ -0,0 +1,432 @@
+
+#ifndef HPP_UTIL_RECTARRAYS_
+#define HPP_UTIL_RECTARRAYS_
+
+#include "macros.hpp"
+#include "rect.hpp"
+#include "typedefs.hpp"
+#include "vec2.hpp"
+#include "vec2x.hpp"
+
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <span>
+#include <vector>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief Many rects stored as a structure-of-arrays of their edges, for the batch queries below
+ * @note Every span must have the same size
+ */
+template<typename T, typename R>
+struct RectSpans {
+    std::span<const PositionScalar<T, R> > leftLst;
+    std::span<const PositionScalar<T, R> > topLst;
+    std::span<const PositionScalar<T, R> > rightLst;
+    std::span<const PositionScalar<T, R> > bottomLst;
+
+    [[nodiscard]] size_t size() const {
+        assert(topLst.size() == leftLst.size() && rightLst.size() == leftLst.size() &&
+               bottomLst.size() == leftLst.size() && "All the arrays must be the same size");
+        return leftLst.size();
+    }
+
+    [[nodiscard]] RectSpans subspan(size_t offset, size_t count) const {
+        return {
+            leftLst.subspan(offset, count),
+            topLst.subspan(offset, count),
+            rightLst.subspan(offset, count),
+            bottomLst.subspan(offset, count),
+        };
+    }
+
+    [[nodiscard]] Rect<T, R> operator[](size_t i) const {
+        return Rect<T, R>::cornerCorner({leftLst[i], topLst[i]}, {rightLst[i], bottomLst[i]});
+    }
+};
+
+
+/**
+ * @brief An owning structure-of-arrays of rects, which converts to RectSpans for the batch queries
+ * @note The edges are stored instead of the centre and half extent, as every query compares edges
+ */
+template<typename T, typename R>
+class RectArrays {
+public:
+    using Scalar = PositionScalar<T, R>;
+
+    [[nodiscard]] size_t size() const noexcept {
+        return mLeftLst.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return mLeftLst.empty();
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept {
+        return mLeftLst.capacity();
+    }
+
+    void reserve(size_t capacity_) {
+        mLeftLst.reserve(capacity_);
+        mTopLst.reserve(capacity_);
+        mRightLst.reserve(capacity_);
+        mBottomLst.reserve(capacity_);
+    }
+
+    void clear() noexcept {
+        mLeftLst.clear();
+        mTopLst.clear();
+        mRightLst.clear();
+        mBottomLst.clear();
+    }
+
+    /**
+     * @brief Change the number of rects, the added rects are zero
+     */
+    void resize(size_t count) {
+        mLeftLst.resize(count);
+        mTopLst.resize(count);
+        mRightLst.resize(count);
+        mBottomLst.resize(count);
+    }
+
+    /**
+     * @param rect - the rect to be added (must be valid)
+     */
+    void push_back(const Rect<T, R>& rect) {
+        assert(rect.isValid() && "RectArrays needs valid rects");
+        mLeftLst.push_back(rect.left() );
+        mTopLst.push_back(rect.top() );
+        mRightLst.push_back(rect.right() );
+        mBottomLst.push_back(rect.bottom() );
+    }
+
+    /**
+     * @param rect - the rect to be stored at index i (must be valid)
+     */
+    void set(size_t i, const Rect<T, R>& rect) {
+        assert(rect.isValid() && "RectArrays needs valid rects");
+        mLeftLst[i] = rect.left();
+        mTopLst[i] = rect.top();
+        mRightLst[i] = rect.right();
+        mBottomLst[i] = rect.bottom();
+    }
+
+    [[nodiscard]] Rect<T, R> operator[](size_t i) const {
+        return spans()[i];
+    }
+
+    [[nodiscard]] RectSpans<T, R> spans() const noexcept {
+        return {mLeftLst, mTopLst, mRightLst, mBottomLst};
+    }
+
+    UTIL_IMPLICIT operator RectSpans<T, R>() const noexcept {
+        return spans();
+    }
+
+    // The edges can be written directly by the batch operations
+
+    [[nodiscard]] std::span<Scalar> leftLst() noexcept {
+        return mLeftLst;
+    }
+
+    [[nodiscard]] std::span<Scalar> topLst() noexcept {
+        return mTopLst;
+    }
+
+    [[nodiscard]] std::span<Scalar> rightLst() noexcept {
+        return mRightLst;
+    }
+
+    [[nodiscard]] std::span<Scalar> bottomLst() noexcept {
+        return mBottomLst;
+    }
+
+private:
+    std::vector<Scalar> mLeftLst{};
+    std::vector<Scalar> mTopLst{};
+    std::vector<Scalar> mRightLst{};
+    std::vector<Scalar> mBottomLst{};
+};
+
+
+// [SECTION]: Batch queries
+// A register of rects at a time, with the same comparisons as the functions for a single rect
+
+/**
+ * @brief Store the lowest N bits of a lessMask as N bytes of 0 or 1
+ */
+template<size_t N>
+UTIL_ALWAYS_INLINE void storeMaskBytes(uint32_t mask, uint8_t* dest) {
+    if constexpr(N <= 4 && std::endian::native == std::endian::little) {
+        // Each shift by 7 moves the next bit to the bottom of the next byte, and the shifted copies don't overlap
+        const uint32_t bytes = (mask * 0x00204081u) & 0x01010101u;
+        std::memcpy(dest, &bytes, N);
+    } else {
+        for(size_t lane = 0; lane < N; ++lane)
+            dest[lane] = static_cast<uint8_t>( (mask >> lane) & 1);
+    }
+}
+
+/**
+ * @brief hasCollision of rect against every rect in rects
+ * @param rect - the rect to be tested against all of them (must be valid)
+ * @param hitLst - set to 1 for each rect that collides, otherwise 0, must be at least as long as rects
+ * @return the number of rects that collide
+ */
+template<typename T, typename R>
+size_t collisionMask(const Rect<T, R>& rect, const RectSpans<T, R>& rects, std::span<uint8_t> hitLst) {
+    assert(rect.isValid() && "collisionMask needs a valid rect");
+    assert(hitLst.size() >= rects.size() );
+    constexpr size_t laneCount = defaultLaneCount<T>;
+    using EdgeX = DimX<laneCount, PositionScalar<T, R> >;
+    const size_t rectCount = rects.size();
+    const auto leftX = EdgeX::broadcast(rect.left() );
+    const auto topX = EdgeX::broadcast(rect.top() );
+    const auto rightX = EdgeX::broadcast(rect.right() );
+    const auto bottomX = EdgeX::broadcast(rect.bottom() );
+    size_t hitCount = 0;
+    size_t i = 0;
+    for(; i + laneCount <= rectCount; i += laneCount) {
+        const uint32_t hitMask = lessMask(leftX, EdgeX::load(rects.rightLst.data() + i) ) &
+                                 lessMask(EdgeX::load(rects.leftLst.data() + i), rightX) &
+                                 lessMask(topX, EdgeX::load(rects.bottomLst.data() + i) ) &
+                                 lessMask(EdgeX::load(rects.topLst.data() + i), bottomX);
+        storeMaskBytes<laneCount>(hitMask, hitLst.data() + i);
+        hitCount += static_cast<size_t>(std::popcount(hitMask) );
+    }
+    for(; i<rectCount; ++i) {
+        const bool isHit = rect.left() < rects.rightLst[i] && rects.leftLst[i] < rect.right() &&
+                           rect.top() < rects.bottomLst[i] && rects.topLst[i] < rect.bottom();
+        hitLst[i] = isHit;
+        hitCount += isHit;
+    }
+    return hitCount;
+}
+
+/**
+ * @brief Rect::contains of pos for every rect in rects, e.g. to find the widgets under the mouse
+ * @param hitLst - set to 1 for each rect that contains pos, otherwise 0, must be at least as long as rects
+ * @return the number of rects that contain pos
+ */
+template<typename T, typename R>
+size_t containsMask(const RectSpans<T, R>& rects, Position<T, R> pos, std::span<uint8_t> hitLst) {
+    assert(hitLst.size() >= rects.size() );
+    constexpr size_t laneCount = defaultLaneCount<T>;
+    using EdgeX = DimX<laneCount, PositionScalar<T, R> >;
+    const size_t rectCount = rects.size();
+    const auto posX = EdgeX::broadcast(pos.x);
+    const auto posY = EdgeX::broadcast(pos.y);
+    size_t hitCount = 0;
+    size_t i = 0;
+    for(; i + laneCount <= rectCount; i += laneCount) {
+        const uint32_t hitMask = lessMask(EdgeX::load(rects.leftLst.data() + i), posX) &
+                                 lessMask(posX, EdgeX::load(rects.rightLst.data() + i) ) &
+                                 lessMask(EdgeX::load(rects.topLst.data() + i), posY) &
+                                 lessMask(posY, EdgeX::load(rects.bottomLst.data() + i) );
+        storeMaskBytes<laneCount>(hitMask, hitLst.data() + i);
+        hitCount += static_cast<size_t>(std::popcount(hitMask) );
+    }
+    for(; i<rectCount; ++i) {
+        const bool isHit = rects.leftLst[i] < pos.x && pos.x < rects.rightLst[i] &&
+                           rects.topLst[i] < pos.y && pos.y < rects.bottomLst[i];
+        hitLst[i] = isHit;
+        hitCount += isHit;
+    }
+    return hitCount;
+}
+
+/**
+ * @brief Rect::contains of every position in posLst
+ * @param hitLst - set to 1 for each position inside rect, otherwise 0, must be at least as long as posLst
+ * @return the number of positions inside rect
+ */
+template<typename T, typename R>
+size_t containsMask(const Rect<T, R>& rect, std::span<const Position<T, R> > posLst, std::span<uint8_t> hitLst) {
+    assert(hitLst.size() >= posLst.size() );
+    constexpr size_t laneCount = defaultLaneCount<T>;
+    using PositionX = Vec2x<laneCount, PositionScalar<T, R> >;
+    using EdgeX = DimX<laneCount, PositionScalar<T, R> >;
+    const size_t posCount = posLst.size();
+    const auto leftX = EdgeX::broadcast(rect.left() );
+    const auto topX = EdgeX::broadcast(rect.top() );
+    const auto rightX = EdgeX::broadcast(rect.right() );
+    const auto bottomX = EdgeX::broadcast(rect.bottom() );
+    size_t hitCount = 0;
+    size_t i = 0;
+    for(; i + laneCount <= posCount; i += laneCount) {
+        const auto posX = PositionX::load(posLst.data() + i);
+        const uint32_t hitMask = lessMask(leftX, posX.x) & lessMask(posX.x, rightX) &
+                                 lessMask(topX, posX.y) & lessMask(posX.y, bottomX);
+        storeMaskBytes<laneCount>(hitMask, hitLst.data() + i);
+        hitCount += static_cast<size_t>(std::popcount(hitMask) );
+    }
+    for(; i<posCount; ++i) {
+        const bool isHit = rect.contains(posLst[i]);
+        hitLst[i] = isHit;
+        hitCount += isHit;
+    }
+    return hitCount;
+}
+
+/**
+ * @brief The intersection of each pair of rects, lhs[i] with rhs[i]
+ * @param out - resized to the number of pairs, and may be the same arrays as lhs or rhs
+ * @note Pairs that don't overlap give a zero-sized rect at the origin, like intersection
+ */
+template<typename T, typename R>
+void intersection(const RectSpans<T, R>& lhs, const RectSpans<T, R>& rhs, RectArrays<T, R>& out) {
+    assert(lhs.size() == rhs.size() && "intersection needs a rhs for every lhs");
+    constexpr size_t laneCount = defaultLaneCount<T>;
+    using EdgeX = DimX<laneCount, PositionScalar<T, R> >;
+    constexpr auto zero = PositionScalar<T, R>::zero();
+    const size_t rectCount = lhs.size();
+    out.resize(rectCount);
+    const auto outLeftLst = out.leftLst();
+    const auto outTopLst = out.topLst();
+    const auto outRightLst = out.rightLst();
+    const auto outBottomLst = out.bottomLst();
+    size_t i = 0;
+    for(; i + laneCount <= rectCount; i += laneCount) {
+        const auto left = max(EdgeX::load(lhs.leftLst.data() + i), EdgeX::load(rhs.leftLst.data() + i) );
+        const auto top = max(EdgeX::load(lhs.topLst.data() + i), EdgeX::load(rhs.topLst.data() + i) );
+        const auto right = min(EdgeX::load(lhs.rightLst.data() + i), EdgeX::load(rhs.rightLst.data() + i) );
+        const auto bottom = min(EdgeX::load(lhs.bottomLst.data() + i), EdgeX::load(rhs.bottomLst.data() + i) );
+        // Blended with zero instead of branching, as pairs that don't overlap are common
+        const auto zeroIfEmpty = [&](const EdgeX& edge) {
+            return zeroWhereLess(zeroWhereLess(edge, right, left), bottom, top);
+        };
+        zeroIfEmpty(left).store(outLeftLst.data() + i);
+        zeroIfEmpty(top).store(outTopLst.data() + i);
+        zeroIfEmpty(right).store(outRightLst.data() + i);
+        zeroIfEmpty(bottom).store(outBottomLst.data() + i);
+    }
+    for(; i<rectCount; ++i) {
+        const auto left = max(lhs.leftLst[i], rhs.leftLst[i]);
+        const auto top = max(lhs.topLst[i], rhs.topLst[i]);
+        const auto right = min(lhs.rightLst[i], rhs.rightLst[i]);
+        const auto bottom = min(lhs.bottomLst[i], rhs.bottomLst[i]);
+        const bool isEmpty = left > right || top > bottom;
+        outLeftLst[i] = isEmpty ? zero : left;
+        outTopLst[i] = isEmpty ? zero : top;
+        outRightLst[i] = isEmpty ? zero : right;
+        outBottomLst[i] = isEmpty ? zero : bottom;
+    }
+}
+
+/**
+ * @brief The smallest rect that contains each pair of rects, lhs[i] and rhs[i]
+ * @param out - resized to the number of pairs, and may be the same arrays as lhs or rhs
+ */
+template<typename T, typename R>
+void boundingRect(const RectSpans<T, R>& lhs, const RectSpans<T, R>& rhs, RectArrays<T, R>& out) {
+    assert(lhs.size() == rhs.size() && "boundingRect needs a rhs for every lhs");
+    constexpr size_t laneCount = defaultLaneCount<T>;
+    using EdgeX = DimX<laneCount, PositionScalar<T, R> >;
+    const size_t rectCount = lhs.size();
+    out.resize(rectCount);
+    const auto outLeftLst = out.leftLst();
+    const auto outTopLst = out.topLst();
+    const auto outRightLst = out.rightLst();
+    const auto outBottomLst = out.bottomLst();
+    size_t i = 0;
+    for(; i + laneCount <= rectCount; i += laneCount) {
+        min(EdgeX::load(lhs.leftLst.data() + i), EdgeX::load(rhs.leftLst.data() + i) ).store(outLeftLst.data() + i);
+        min(EdgeX::load(lhs.topLst.data() + i), EdgeX::load(rhs.topLst.data() + i) ).store(outTopLst.data() + i);
+        max(EdgeX::load(lhs.rightLst.data() + i), EdgeX::load(rhs.rightLst.data() + i) ).store(outRightLst.data() + i);
+        max(EdgeX::load(lhs.bottomLst.data() + i), EdgeX::load(rhs.bottomLst.data() + i) ).store(outBottomLst.data() + i);
+    }
+    for(; i<rectCount; ++i) {
+        outLeftLst[i] = min(lhs.leftLst[i], rhs.leftLst[i]);
+        outTopLst[i] = min(lhs.topLst[i], rhs.topLst[i]);
+        outRightLst[i] = max(lhs.rightLst[i], rhs.rightLst[i]);
+        outBottomLst[i] = max(lhs.bottomLst[i], rhs.bottomLst[i]);
+    }
+}
+
+/**
+ * @brief The smallest rect that contains every rect, e.g. the bounds of a broadphase cell
+ * @return the bounding rect, or a zero-sized rect at the origin when there are no rects
+ */
+template<typename T, typename R>
+[[nodiscard]] Rect<T, R> boundingRect(const RectSpans<T, R>& rects) {
+    constexpr size_t laneCount = defaultLaneCount<T>;
+    using EdgeX = DimX<laneCount, PositionScalar<T, R> >;
+    const size_t rectCount = rects.size();
+    if(rectCount == 0)
+        return Rect<T, R>::zero();
+    auto leftX = EdgeX::broadcast(rects.leftLst[0]);
+    auto topX = EdgeX::broadcast(rects.topLst[0]);
+    auto rightX = EdgeX::broadcast(rects.rightLst[0]);
+    auto bottomX = EdgeX::broadcast(rects.bottomLst[0]);
+    size_t i = 0;
+    for(; i + laneCount <= rectCount; i += laneCount) {
+        leftX = min(leftX, EdgeX::load(rects.leftLst.data() + i) );
+        topX = min(topX, EdgeX::load(rects.topLst.data() + i) );
+        rightX = max(rightX, EdgeX::load(rects.rightLst.data() + i) );
+        bottomX = max(bottomX, EdgeX::load(rects.bottomLst.data() + i) );
+    }
+    auto left = leftX[0];
+    auto top = topX[0];
+    auto right = rightX[0];
+    auto bottom = bottomX[0];
+    for(size_t lane = 1; lane < laneCount; ++lane) {
+        left = min(left, leftX[lane]);
+        top = min(top, topX[lane]);
+        right = max(right, rightX[lane]);
+        bottom = max(bottom, bottomX[lane]);
+    }
+    for(; i<rectCount; ++i) {
+        left = min(left, rects.leftLst[i]);
+        top = min(top, rects.topLst[i]);
+        right = max(right, rects.rightLst[i]);
+        bottom = max(bottom, rects.bottomLst[i]);
+    }
+    return Rect<T, R>::cornerCorner({left, top}, {right, bottom});
+}
+
+/**
+ * @brief Grow every rect by margin on each side, e.g. the fat rects of a broadphase
+ * @param margin - added to the left and right, and to the top and bottom, negative margins shrink the rects
+ * @note The rects must stay valid, so negative margins must not be more than half the size of any rect
+ */
+template<typename T, typename R>
+void expand(RectArrays<T, R>& rects, Displacement<T, R> margin) {
+    constexpr size_t laneCount = defaultLaneCount<T>;
+    using EdgeX = DimX<laneCount, PositionScalar<T, R> >;
+    const size_t rectCount = rects.size();
+    const auto leftLst = rects.leftLst();
+    const auto topLst = rects.topLst();
+    const auto rightLst = rects.rightLst();
+    const auto bottomLst = rects.bottomLst();
+    const auto marginX = EdgeX::broadcast(margin.x);
+    const auto marginY = EdgeX::broadcast(margin.y);
+    size_t i = 0;
+    for(; i + laneCount <= rectCount; i += laneCount) {
+        (EdgeX::load(leftLst.data() + i) - marginX).store(leftLst.data() + i);
+        (EdgeX::load(topLst.data() + i) - marginY).store(topLst.data() + i);
+        (EdgeX::load(rightLst.data() + i) + marginX).store(rightLst.data() + i);
+        (EdgeX::load(bottomLst.data() + i) + marginY).store(bottomLst.data() + i);
+    }
+    for(; i<rectCount; ++i) {
+        leftLst[i] -= margin.x;
+        topLst[i] -= margin.y;
+        rightLst[i] += margin.x;
+        bottomLst[i] += margin.y;
+    }
+}
+
+
+using BaseRectSpans = RectSpans<Real, BaseRatio>;
+using BaseRectArrays = RectArrays<Real, BaseRatio>;
+
+
+}  // namespace Util
+
+#endif  // HPP_UTIL_RECTARRAYS_
@@ -0,0 +1,290 @@
+
+#ifndef HPP_UTIL_REGISTRY_
+#define HPP_UTIL_REGISTRY_
+
+#include "sparse_set.hpp"
+#include "typedefs.hpp"
+#include "worker_pool.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace Util
+{
+
+
+template<typename... Ts>
+struct TypeList {};
+
+template<typename T, typename... Ts>
+inline constexpr bool containsType = (std::is_same_v<T, Ts> || ...);
+
+template<typename Lhs, typename Rhs>
+inline constexpr bool sharesType = false;
+
+template<typename... Lhs, typename... Rhs>
+inline constexpr bool sharesType<TypeList<Lhs...>, TypeList<Rhs...> > = (containsType<Lhs, Rhs...> || ...);
+
+
+/**
+ * @brief The entities and their components, with a SparseSet for each type of component
+ * @tparam Components - every type of component, so the pools are found at compile time
+ * @example Registry<Circle, Velocity> registry; const Entity entity = registry.create();
+ *          registry.emplace<Velocity>(entity, ...);
+ *          registry.each<Circle, const Velocity>([](Entity, Circle& circle, const Velocity& vel){...});
+ */
+template<typename... Components>
+class Registry {
+public:
+    /**
+     * @brief Create an entity without any components, reusing the index of a destroyed entity if there is one
+     */
+    Entity create() {
+        if(!mFreeIndexLst.empty() ) {
+            const uint32_t index = mFreeIndexLst.back();
+            mFreeIndexLst.pop_back();
+            return {index, mGenerationLst[index]};
+        }
+        mGenerationLst.push_back(0);
+        return {static_cast<uint32_t>(mGenerationLst.size() - 1), 0};
+    }
+
+    /**
+     * @brief Remove every component of the entity, after which its id is no longer alive
+     */
+    void destroy(Entity entity) {
+        assert(isAlive(entity) && "Cannot destroy an entity that isn't alive");
+        (pool<Components>().erase(entity), ...);
+        ++mGenerationLst[entity.index];
+        mFreeIndexLst.push_back(entity.index);
+    }
+
+    [[nodiscard]] bool isAlive(Entity entity) const noexcept {
+        return entity.index < mGenerationLst.size() && mGenerationLst[entity.index] == entity.generation;
+    }
+
+    [[nodiscard]] size_t aliveCount() const noexcept {
+        return mGenerationLst.size() - mFreeIndexLst.size();
+    }
+
+    /**
+     * @brief Make room for count entities in the registry and in every pool
+     */
+    void reserve(size_t count) {
+        mGenerationLst.reserve(count);
+        (pool<Components>().reserve(count), ...);
+    }
+
+    /**
+     * @brief The bytes allocated for the entities and every pool
+     */
+    [[nodiscard]] size_t capacityBytes() const noexcept {
+        return (mGenerationLst.capacity() + mFreeIndexLst.capacity() ) * sizeof(uint32_t) +
+               (pool<Components>().capacityBytes() + ...);
+    }
+
+    template<typename T>
+    [[nodiscard]] SparseSet<T>& pool() noexcept {
+        static_assert(containsType<T, Components...>, "The component isn't one of the registry's");
+        return std::get<SparseSet<T> >(mPoolLst);
+    }
+
+    template<typename T>
+    [[nodiscard]] const SparseSet<T>& pool() const noexcept {
+        static_assert(containsType<T, Components...>, "The component isn't one of the registry's");
+        return std::get<SparseSet<T> >(mPoolLst);
+    }
+
+    template<typename T, typename... Args>
+    T& emplace(Entity entity, Args&&... args) {
+        assert(isAlive(entity) && "Cannot add a component to an entity that isn't alive");
+        return pool<T>().emplace(entity, std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    void erase(Entity entity) {
+        pool<T>().erase(entity);
+    }
+
+    template<typename T>
+    [[nodiscard]] bool has(Entity entity) const noexcept {
+        return pool<T>().contains(entity);
+    }
+
+    template<typename T>
+    [[nodiscard]] T& get(Entity entity) {
+        return pool<T>().get(entity);
+    }
+
+    template<typename T>
+    [[nodiscard]] const T& get(Entity entity) const {
+        return pool<T>().get(entity);
+    }
+
+    template<typename T>
+    [[nodiscard]] T* tryGet(Entity entity) {
+        return pool<T>().tryGet(entity);
+    }
+
+    template<typename T>
+    [[nodiscard]] const T* tryGet(Entity entity) const {
+        return pool<T>().tryGet(entity);
+    }
+
+    /**
+     * @brief Call f(entity, components...) for every entity with all of the components Ts
+     * @note Iterates the pool of the first component linearly, so put the rarest one first, e.g. a tag
+     * @note Mark the components that are only read as const
+     * @note f mustn't add or remove the components Ts, as that moves the other components of the pool
+     */
+    template<typename... Ts, typename F>
+    void each(const F& f) {
+        eachImpl<Ts...>(*this, f);
+    }
+
+    template<typename... Ts, typename F>
+    void each(const F& f) const {
+        static_assert( (std::is_const_v<Ts> && ...), "A const registry can only give const components");
+        eachImpl<Ts...>(*this, f);
+    }
+
+    void clear() noexcept {
+        (pool<Components>().clear(), ...);
+        mGenerationLst.clear();
+        mFreeIndexLst.clear();
+    }
+
+private:
+    // The components of the driving pool's entities, if they are a run in the same order in the other pool
+    // That's the case for entities that were given their components in the same order, and were never erased
+    template<typename T, typename Self>
+    [[nodiscard]] static std::span<T> alignedComponents(Self& self, std::span<const Entity> drivingEntityLst) {
+        auto& pool = self.template pool<std::remove_const_t<T> >();
+        const auto entityLst = pool.entities();
+        const uint32_t first = pool.denseIndex(drivingEntityLst.front() );
+        // Entity has no padding, so the ids can be compared as bytes
+        static_assert(std::has_unique_object_representations_v<Entity>);
+        if(first == pool.npos || entityLst.size() - first < drivingEntityLst.size() ||
+           std::memcmp(drivingEntityLst.data(), entityLst.data() + first, drivingEntityLst.size_bytes() ) != 0)
+            return {};
+        return pool.components().subspan(first, drivingEntityLst.size() );
+    }
+
+    // Finds the components of the entities of the driving pool in another pool, in the same order
+    // The offset between the two pools' indices is remembered, as entities that were given their components
+    // in the same order keep the same offset, so usually the sparse array isn't needed
+    template<typename T, typename Pool>
+    class Cursor {
+    public:
+        explicit Cursor(Pool& pool_) :
+            rPool{pool_}
+        {}
+
+        [[nodiscard]] T* find(Entity entity, size_t i) {
+            const auto entityLst = rPool.entities();
+            const size_t guess = i + mOffset;
+            if(guess < entityLst.size() && entityLst[guess] == entity)
+                return &rPool.components()[guess];
+            const uint32_t index = rPool.denseIndex(entity);
+            if(index == Pool::npos)
+                return nullptr;
+            mOffset = index - i;
+            return &rPool.components()[index];
+        }
+
+    private:
+        Pool& rPool;
+        size_t mOffset{}; // wraps around when the index is less than i
+    };
+
+    template<typename T, typename Self>
+    [[nodiscard]] static auto makeCursor(Self& self) {
+        auto& pool = self.template pool<std::remove_const_t<T> >();
+        return Cursor<T, std::remove_reference_t<decltype(pool)> >{pool};
+    }
+
+    template<typename T, typename... Ts, typename Self, typename F>
+    static void eachImpl(Self& self, const F& f) {
+        auto& drivingPool = self.template pool<std::remove_const_t<T> >();
+        const auto entityLst = drivingPool.entities();
+        const auto componentLst = drivingPool.components();
+        if(entityLst.empty() )
+            return;
+
+        // Usually every pool is aligned with the driving one, then the components are found by index
+        const std::tuple<std::span<Ts>...> alignedLst{alignedComponents<Ts>(self, entityLst)...};
+        const bool isAligned = std::apply([&](const auto&... components) {
+            return ( (components.size() == entityLst.size() ) && ...);
+        }, alignedLst);
+        if(isAligned) {
+            std::apply([&](const auto&... components) {
+                for(size_t i=0; i<entityLst.size(); ++i)
+                    f(entityLst[i], static_cast<T&>(componentLst[i]), components[i]...);
+            }, alignedLst);
+            return;
+        }
+
+        std::tuple cursorLst{makeCursor<Ts>(self)...};
+        for(size_t i=0; i<entityLst.size(); ++i) {
+            const Entity entity = entityLst[i];
+            const std::tuple<Ts*...> otherLst = std::apply([&](auto&... cursor) {
+                return std::tuple<Ts*...>{cursor.find(entity, i)...};
+            }, cursorLst);
+            const bool hasAll = std::apply([](const auto*... component) {
+                return ( (component != nullptr) && ...);
+            }, otherLst);
+            if(!hasAll)
+                continue;
+            std::apply([&](Ts*... component) {
+                f(entity, static_cast<T&>(componentLst[i]), *component...);
+            }, otherLst);
+        }
+    }
+
+    std::tuple<SparseSet<Components>...> mPoolLst{};
+    std::vector<uint32_t> mGenerationLst{}; // by the entity's index
+    std::vector<uint32_t> mFreeIndexLst{};
+};
+
+
+// [SECTION]: Systems
+// A system is a callable that takes the registry, and lists the components it reads and writes, e.g.
+// struct Move { using Reads = TypeList<Velocity>; using Writes = TypeList<Circle>; void operator()(World&) const; };
+
+template<typename Lhs, typename Rhs>
+inline constexpr bool systemsConflict =
+    sharesType<typename Lhs::Writes, typename Rhs::Writes> ||
+    sharesType<typename Lhs::Writes, typename Rhs::Reads> ||
+    sharesType<typename Rhs::Writes, typename Lhs::Reads>;
+
+template<typename... Systems>
+inline constexpr bool anySystemsConflict = false;
+
+template<typename System, typename... Others>
+inline constexpr bool anySystemsConflict<System, Others...> =
+    (systemsConflict<System, Others> || ...) || anySystemsConflict<Others...>;
+
+/**
+ * @brief Run the systems at the same time on the worker threads, and wait for all of them to be done
+ * @note None of the systems may write a component that another one reads or writes, which is checked at compile time
+ * @note The systems mustn't create or destroy entities, add or remove components, or call parallelFor themselves
+ */
+template<typename R, typename... Systems>
+void runParallel(WorkerPool& workerPool, R& registry, const Systems&... systems) {
+    static_assert(!anySystemsConflict<Systems...>, "Systems that run in parallel cannot write the same components");
+    workerPool.parallelFor(sizeof...(Systems), [&](size_t task) {
+        size_t systemIndex = 0;
+        ( (systemIndex++ == task ? systems(registry) : void() ), ...);
+    });
+}
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_REGISTRY_
@@ -1,8 +1,12 @@
 
 #include "rng.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <limits>
 
 
 namespace Util
@@ -15,9 +19,24 @@ namespace
 
 // TODO: check out random_device and other random methods
 // for now just use current time
-auto getSeed() {
+uint64_t getSeed() {
     const auto seed = std::chrono::steady_clock::now().time_since_epoch().count();
-    return static_cast<std::mt19937::result_type>(seed);
+    return static_cast<uint64_t>(seed);
+}
+
+// Spreads the seed over the state, so that similar seeds give unrelated sequences
+// and the state is never all zero
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30) ) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27) ) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+// The top 24 bits fill the mantissa, so every value is exact and below 1
+float toUnitFloat(uint32_t bits) {
+    constexpr float floatEpsilon = 1.0f / static_cast<float>(uint32_t{1} << 24);
+    return static_cast<float>(bits >> 8) * floatEpsilon;
 }
 
 
@@ -25,16 +44,67 @@ auto getSeed() {
 
 
 Rng::Rng() :
-    mRngEngine{getSeed()}
+    Rng{getSeed()}
 {}
 
+Rng::Rng(uint64_t seed_) :
+    mState{}
+{
+    for(size_t i=0; i<mState.size(); i+=2) {
+        const uint64_t value = splitMix64(seed_);
+        mState[i] = static_cast<uint32_t>(value);
+        mState[i + 1] = static_cast<uint32_t>(value >> 32);
+    }
+}
+
+uint32_t Rng::next() {
+    const uint32_t result = mState[0] + mState[3];
+    const uint32_t t = mState[1] << 9;
+    mState[2] ^= mState[0];
+    mState[3] ^= mState[1];
+    mState[1] ^= mState[2];
+    mState[0] ^= mState[3];
+    mState[2] ^= t;
+    mState[3] = std::rotl(mState[3], 11);
+    return result;
+}
+
 float Rng::getFloat(float minimum, float maximum) {
     assert(minimum <= maximum);
     assert(maximum - minimum <= std::numeric_limits<float>::max() );
-    std::uniform_real_distribution distr{minimum, maximum};
-    return distr(mRngEngine);
+    // Rounding can give the maximum for very small ranges, so it's clamped below it
+    const float value = minimum + (maximum - minimum) * toUnitFloat(next() );
+    return value < maximum ? value : std::max(minimum, std::nextafter(maximum, minimum) );
 }
 
+void Rng::fillFloats(std::span<float> out, float minimum, float maximum) {
+    // A local copy of the state, so that it can be kept in registers
+    Rng rng = *this;
+    for(float& value : out)
+        value = rng.getFloat(minimum, maximum);
+    *this = rng;
+}
 
-} // namespace Util
+void Rng::jump() {
+    constexpr std::array<uint32_t, 4> jumpPolynomial = {0x8764000B, 0xF542D2D3, 0x6FA035C3, 0x77F2DB5B};
+    std::array<uint32_t, 4> jumped{};
+    for(const uint32_t word : jumpPolynomial) {
+        for(unsigned bit=0; bit<32; ++bit) {
+            if(word & (uint32_t{1} << bit) ) {
+                for(size_t i=0; i<jumped.size(); ++i)
+                    jumped[i] ^= mState[i];
+            }
+            static_cast<void>(next() );
+        }
+    }
+    mState = jumped;
+}
 
+Rng Rng::split() {
+    Rng stream = *this;
+    jump();
+    return stream;
+}
+
+
+} // namespace Util
@@ -2,7 +2,10 @@
 #ifndef HPP_UTIL_RNG_
 #define HPP_UTIL_RNG_
 
-#include <random>
+#include "typedefs.hpp"
+
+#include <array>
+#include <span>
 
 
 namespace Util
@@ -10,16 +13,40 @@ namespace Util
 
 
 /**
- * @brief Very simple rng engine
+ * @brief A small and fast rng engine (xoshiro128+), that can be split into independent streams
+ * @note The same seed gives the same sequence on every platform, and the state is only 16 bytes,
+ *       so it's cheap to copy into a snapshot
+ * @note Not thread safe, give each thread its own stream with split()
  */
 class Rng {
 public:
+    // Seeded from the current time
     explicit Rng();
+    // The same seed gives the same sequence, for reproducible runs
+    explicit Rng(uint64_t seed_);
 
+    [[nodiscard]] uint32_t next();
+    /**
+     * @return a uniform float in [minimum, maximum)
+     */
     float getFloat(float minimum, float maximum);
+    /**
+     * @brief Fill the span with uniform floats in [minimum, maximum), the same as calling getFloat for each
+     */
+    void fillFloats(std::span<float> out, float minimum, float maximum);
+
+    /**
+     * @brief Advance the sequence by 2^64 numbers
+     */
+    void jump();
+    /**
+     * @brief Make a stream that won't overlap with this one, e.g. for a worker thread
+     * @return an engine at the current position, while this one jumps ahead
+     */
+    [[nodiscard]] Rng split();
 
 private:
-    std::mt19937 mRngEngine;
+    std::array<uint32_t, 4> mState;
 };
 
 
@@ -0,0 +1,286 @@
+
+#ifndef HPP_UTIL_SMALLVECTOR_
+#define HPP_UTIL_SMALLVECTOR_
+
+#include "typedefs.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief A vector that keeps up to N elements inside the object, and only allocates when it grows past them
+ * @note For lists that almost always hold a handful of elements, so they don't need a heap allocation
+ *       and are next to the rest of their owner in memory
+ * @note Like std::vector, inserting can move every element, so iterators and references are invalidated
+ * @note Not constexpr, unlike StaticVector: the inline elements are constructed in raw bytes, which needs
+ *       reinterpret_cast, and constant expressions can't do that. Use a StaticVector for constexpr tables
+ */
+template<typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "A SmallVector without inline elements is a std::vector");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+
+    SmallVector() noexcept = default;
+
+    SmallVector(std::initializer_list<T> init) {
+        copyFrom(init.begin(), init.size() );
+    }
+
+    SmallVector(const SmallVector& other) {
+        copyFrom(other.begin(), other.mSize);
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        takeFrom(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if(this != &other) {
+            clear();
+            copyFrom(other.begin(), other.mSize);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if(this != &other) {
+            clear();
+            freeHeap();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        freeHeap();
+    }
+
+
+    // Capacity
+
+    [[nodiscard]] size_t size() const noexcept {
+        return mSize;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept {
+        return mCapacity;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return mSize == 0;
+    }
+
+    /**
+     * @brief Checks if the elements are still inside the object
+     */
+    [[nodiscard]] bool isInline() const noexcept {
+        return mHeapData == nullptr;
+    }
+
+    void reserve(size_t capacity_) {
+        if(capacity_ > mCapacity)
+            reallocate(capacity_);
+    }
+
+
+    // Element access
+
+    [[nodiscard]] T* data() noexcept {
+        return mHeapData ? mHeapData : inlineData();
+    }
+
+    [[nodiscard]] const T* data() const noexcept {
+        return mHeapData ? mHeapData : inlineData();
+    }
+
+    [[nodiscard]] T& operator[](size_t i) {
+        assert(i < mSize && "Index out of range");
+        return data()[i];
+    }
+
+    [[nodiscard]] const T& operator[](size_t i) const {
+        assert(i < mSize && "Index out of range");
+        return data()[i];
+    }
+
+    [[nodiscard]] T& front() {
+        return (*this)[0];
+    }
+
+    [[nodiscard]] const T& front() const {
+        return (*this)[0];
+    }
+
+    [[nodiscard]] T& back() {
+        return (*this)[mSize - 1];
+    }
+
+    [[nodiscard]] const T& back() const {
+        return (*this)[mSize - 1];
+    }
+
+
+    // Iterators
+
+    [[nodiscard]] iterator begin() noexcept {
+        return data();
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return data();
+    }
+
+    [[nodiscard]] iterator end() noexcept {
+        return data() + mSize;
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return data() + mSize;
+    }
+
+
+    // Modifiers
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if(mSize == mCapacity) {
+            // Constructed first, as args may refer to an element that is about to move
+            T value(std::forward<Args>(args)...);
+            reallocate(mCapacity * 2);
+            return *std::construct_at(data() + mSize++, std::move(value) );
+        }
+        return *std::construct_at(data() + mSize++, std::forward<Args>(args)...);
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value) );
+    }
+
+    /**
+     * @brief Insert value before pos, moving the later elements back by one
+     * @return an iterator to the inserted element
+     */
+    iterator insert(const_iterator pos, T value) {
+        const auto index = pos - begin();
+        emplace_back(std::move(value) );
+        std::rotate(begin() + index, end() - 1, end() );
+        return begin() + index;
+    }
+
+    /**
+     * @brief Remove the element at pos, moving the later elements forward by one
+     * @return an iterator to the element after the removed one
+     */
+    iterator erase(const_iterator pos) {
+        const iterator erasePos = begin() + (pos - begin() );
+        std::move(erasePos + 1, end(), erasePos);
+        pop_back();
+        return erasePos;
+    }
+
+    void pop_back() {
+        assert(mSize > 0 && "The SmallVector is empty");
+        std::destroy_at(data() + --mSize);
+    }
+
+    /**
+     * @brief Destroy every element, the capacity stays the same
+     */
+    void clear() noexcept {
+        std::destroy(begin(), end() );
+        mSize = 0;
+    }
+
+private:
+    [[nodiscard]] T* inlineData() noexcept {
+        return std::launder(reinterpret_cast<T*>(mInlineBuffer) );
+    }
+
+    [[nodiscard]] const T* inlineData() const noexcept {
+        return std::launder(reinterpret_cast<const T*>(mInlineBuffer) );
+    }
+
+    // If moving an element throws, the elements and capacity stay the same
+    void reallocate(size_t capacity_) {
+        T* const newData = std::allocator<T>{}.allocate(capacity_);
+        try {
+            std::uninitialized_move(begin(), end(), newData);
+        } catch(...) {
+            std::allocator<T>{}.deallocate(newData, capacity_);
+            throw;
+        }
+        std::destroy(begin(), end() );
+        freeHeap();
+        mHeapData = newData;
+        mCapacity = capacity_;
+    }
+
+    // This must be empty. If copying an element throws, it stays empty and inline, so a constructor doesn't leak
+    void copyFrom(const T* first, size_t count) {
+        reserve(count);
+        try {
+            std::uninitialized_copy(first, first + count, data() );
+        } catch(...) {
+            freeHeap();
+            throw;
+        }
+        mSize = count;
+    }
+
+    void freeHeap() noexcept {
+        if(mHeapData)
+            std::allocator<T>{}.deallocate(mHeapData, mCapacity);
+        mHeapData = nullptr;
+        mCapacity = N;
+    }
+
+    // Leaves other empty, this must be empty and inline
+    void takeFrom(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if(other.mHeapData) {
+            mHeapData = std::exchange(other.mHeapData, nullptr);
+            mCapacity = std::exchange(other.mCapacity, N);
+            mSize = std::exchange(other.mSize, 0);
+        } else {
+            std::uninitialized_move(other.begin(), other.end(), inlineData() );
+            mSize = other.mSize;
+            other.clear();
+        }
+    }
+
+    alignas(T) std::byte mInlineBuffer[N * sizeof(T)];
+    T* mHeapData = nullptr;
+    size_t mSize = 0;
+    size_t mCapacity = N;
+};
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_SMALLVECTOR_
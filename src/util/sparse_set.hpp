@@ -0,0 +1,170 @@
+
+#ifndef HPP_UTIL_SPARSESET_
+#define HPP_UTIL_SPARSESET_
+
+#include "typedefs.hpp"
+
+#include <cassert>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief The id of an entity in a Registry
+ * @note The generation is increased when an index is reused, so an old id doesn't refer to the new entity
+ */
+struct Entity {
+    uint32_t index;
+    uint32_t generation;
+
+    [[nodiscard]] friend constexpr bool operator==(Entity lhs, Entity rhs) = default;
+};
+
+inline constexpr Entity nullEntity{std::numeric_limits<uint32_t>::max(), 0};
+
+
+/**
+ * @brief The components of type T, stored densely with the entity that owns each of them
+ * @note Finding an entity's component is a lookup in a sparse array indexed by the entity,
+ *       and iterating the components is linear through the dense array
+ * @note Erasing moves the last component into the gap, so the order isn't kept
+ */
+template<typename T>
+class SparseSet {
+public:
+    [[nodiscard]] size_t size() const noexcept {
+        return mEntityLst.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return mEntityLst.empty();
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept {
+        return mEntityLst.capacity();
+    }
+
+    /**
+     * @brief The bytes allocated for the dense and sparse arrays
+     */
+    [[nodiscard]] size_t capacityBytes() const noexcept {
+        return mEntityLst.capacity() * (sizeof(Entity) + sizeof(T) ) + mDenseIndexLst.capacity() * sizeof(uint32_t);
+    }
+
+    void reserve(size_t capacity_) {
+        mEntityLst.reserve(capacity_);
+        mComponentLst.reserve(capacity_);
+    }
+
+    [[nodiscard]] bool contains(Entity entity) const noexcept {
+        return denseIndex(entity) != npos;
+    }
+
+    /**
+     * @brief The index of the entity's component in components(), or npos if it doesn't have one
+     */
+    [[nodiscard]] uint32_t denseIndex(Entity entity) const noexcept {
+        if(entity.index >= mDenseIndexLst.size() )
+            return npos;
+        const uint32_t index = mDenseIndexLst[entity.index];
+        return (index != npos && mEntityLst[index] == entity) ? index : npos;
+    }
+
+    /**
+     * @param entity - must have the component
+     */
+    [[nodiscard]] T& get(Entity entity) {
+        assert(contains(entity) && "The entity doesn't have the component");
+        return mComponentLst[mDenseIndexLst[entity.index]];
+    }
+
+    /**
+     * @param entity - must have the component
+     */
+    [[nodiscard]] const T& get(Entity entity) const {
+        assert(contains(entity) && "The entity doesn't have the component");
+        return mComponentLst[mDenseIndexLst[entity.index]];
+    }
+
+    [[nodiscard]] T* tryGet(Entity entity) {
+        const uint32_t index = denseIndex(entity);
+        return index != npos ? &mComponentLst[index] : nullptr;
+    }
+
+    [[nodiscard]] const T* tryGet(Entity entity) const {
+        const uint32_t index = denseIndex(entity);
+        return index != npos ? &mComponentLst[index] : nullptr;
+    }
+
+    /**
+     * @brief Add the component to the entity, or replace the one it has
+     */
+    template<typename... Args>
+    T& emplace(Entity entity, Args&&... args) {
+        assert(entity.index != nullEntity.index && "Cannot add a component to the null entity");
+        if(T* component = tryGet(entity) ) {
+            *component = T(std::forward<Args>(args)...);
+            return *component;
+        }
+        if(entity.index >= mDenseIndexLst.size() )
+            mDenseIndexLst.resize(entity.index + 1, npos);
+        mDenseIndexLst[entity.index] = static_cast<uint32_t>(mEntityLst.size() );
+        mEntityLst.push_back(entity);
+        return mComponentLst.emplace_back(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Remove the entity's component, if it has one
+     */
+    void erase(Entity entity) {
+        const uint32_t index = denseIndex(entity);
+        if(index == npos)
+            return;
+        if(index + 1 != mEntityLst.size() ) {
+            const Entity last = mEntityLst.back();
+            mEntityLst[index] = last;
+            mComponentLst[index] = std::move(mComponentLst.back() );
+            mDenseIndexLst[last.index] = index;
+        }
+        mDenseIndexLst[entity.index] = npos;
+        mEntityLst.pop_back();
+        mComponentLst.pop_back();
+    }
+
+    void clear() noexcept {
+        mDenseIndexLst.clear();
+        mEntityLst.clear();
+        mComponentLst.clear();
+    }
+
+    // The owners of the components, in the same order as components()
+    [[nodiscard]] std::span<const Entity> entities() const noexcept {
+        return mEntityLst;
+    }
+
+    [[nodiscard]] std::span<T> components() noexcept {
+        return mComponentLst;
+    }
+
+    [[nodiscard]] std::span<const T> components() const noexcept {
+        return mComponentLst;
+    }
+
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+private:
+    std::vector<uint32_t> mDenseIndexLst{}; // by the entity's index
+    std::vector<Entity> mEntityLst{};
+    std::vector<T> mComponentLst{};
+};
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_SPARSESET_
@@ -0,0 +1,203 @@
+
+#ifndef HPP_UTIL_STATICVECTOR_
+#define HPP_UTIL_STATICVECTOR_
+
+#include "typedefs.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief A vector with a fixed capacity and its elements inside the object, so it never allocates
+ * @note The unused elements are default constructed rather than left uninitialised,
+ *       so that a StaticVector can be a constexpr variable, e.g. a table of animation frames
+ * @note Going over the capacity is a bug, like indexing past the end
+ * @example constexpr StaticVector<int, 4> primeLst = {2, 3, 5};
+ */
+template<typename T, size_t N>
+class StaticVector {
+    static_assert(std::is_default_constructible_v<T>, "StaticVector default constructs its unused elements");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+
+    constexpr StaticVector() = default;
+
+    constexpr StaticVector(std::initializer_list<T> init) :
+        mSize{init.size()}
+    {
+        assert(init.size() <= N && "Too many elements for the StaticVector");
+        std::copy(init.begin(), init.end(), mData.begin() );
+    }
+
+
+    // Capacity
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return mSize;
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept {
+        return N;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return mSize == 0;
+    }
+
+    [[nodiscard]] constexpr bool full() const noexcept {
+        return mSize == N;
+    }
+
+
+    // Element access
+
+    [[nodiscard]] constexpr T* data() noexcept {
+        return mData.data();
+    }
+
+    [[nodiscard]] constexpr const T* data() const noexcept {
+        return mData.data();
+    }
+
+    [[nodiscard]] constexpr T& operator[](size_t i) {
+        assert(i < mSize && "Index out of range");
+        return mData[i];
+    }
+
+    [[nodiscard]] constexpr const T& operator[](size_t i) const {
+        assert(i < mSize && "Index out of range");
+        return mData[i];
+    }
+
+    [[nodiscard]] constexpr T& front() {
+        return (*this)[0];
+    }
+
+    [[nodiscard]] constexpr const T& front() const {
+        return (*this)[0];
+    }
+
+    [[nodiscard]] constexpr T& back() {
+        return (*this)[mSize - 1];
+    }
+
+    [[nodiscard]] constexpr const T& back() const {
+        return (*this)[mSize - 1];
+    }
+
+
+    // Iterators
+
+    [[nodiscard]] constexpr iterator begin() noexcept {
+        return data();
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+        return data();
+    }
+
+    [[nodiscard]] constexpr iterator end() noexcept {
+        return data() + mSize;
+    }
+
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+        return data() + mSize;
+    }
+
+
+    // Modifiers
+
+    template<typename... Args>
+    constexpr T& emplace_back(Args&&... args) {
+        assert(mSize < N && "The StaticVector is full");
+        mData[mSize] = T(std::forward<Args>(args)...);
+        return mData[mSize++];
+    }
+
+    constexpr void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    constexpr void push_back(T&& value) {
+        emplace_back(std::move(value) );
+    }
+
+    /**
+     * @brief Insert value before pos, moving the later elements back by one
+     * @return an iterator to the inserted element
+     */
+    constexpr iterator insert(const_iterator pos, T value) {
+        assert(mSize < N && "The StaticVector is full");
+        const auto index = pos - begin();
+        const iterator insertPos = begin() + index;
+        std::move_backward(insertPos, end(), end() + 1);
+        *insertPos = std::move(value);
+        ++mSize;
+        return insertPos;
+    }
+
+    /**
+     * @brief Remove the element at pos, moving the later elements forward by one
+     * @return an iterator to the element after the removed one
+     */
+    constexpr iterator erase(const_iterator pos) {
+        const iterator erasePos = begin() + (pos - begin() );
+        std::move(erasePos + 1, end(), erasePos);
+        pop_back();
+        return erasePos;
+    }
+
+    constexpr void pop_back() {
+        assert(mSize > 0 && "The StaticVector is empty");
+        // Reset, so that the element releases what it holds
+        mData[--mSize] = T{};
+    }
+
+    constexpr void clear() {
+        while(mSize > 0)
+            pop_back();
+    }
+
+    /**
+     * @brief Change the number of elements, the added elements are default constructed
+     */
+    constexpr void resize(size_t count) {
+        assert(count <= N && "Too many elements for the StaticVector");
+        while(mSize > count)
+            pop_back();
+        mSize = count;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const StaticVector& lhs, const StaticVector& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end() );
+    }
+
+private:
+    std::array<T, N> mData{};
+    size_t mSize = 0;
+};
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_STATICVECTOR_
@@ -37,6 +37,9 @@ struct Vec2 {
         return sqrt(x*x + y*y);
     }
 
+    /**
+     * @note The vector must not be zero, see unitOrZero and unitFast
+     */
     [[nodiscard]] auto unit() const {
         const auto vecMag = magnitude();
         using NoUnit = decltype(std::declval<U>() / vecMag);
@@ -46,6 +49,31 @@ struct Vec2 {
         };
     }
 
+    /**
+     * @return the unit vector, or zero for a zero vector
+     */
+    [[nodiscard]] auto unitOrZero() const {
+        using UnitVec = decltype(unit() );
+        if(squareMag().isZero() )
+            return UnitVec::zero();
+        return unit();
+    }
+
+    /**
+     * @brief An approximate unit vector, with a relative error below 1e-5, for hot paths
+     * @return the unit vector, or zero for a zero vector
+     * @note Uses fastRsqrt instead of a sqrt and two divisions
+     * @note Vectors so short that their square magnitude underflows come out near zero, not unit length
+     */
+    [[nodiscard]] auto unitFast() const {
+        using UnitVec = decltype(unit() );
+        using NoUnit = typename UnitVec::Underlying;
+        using T = typename NoUnit::Underlying;
+        // Clamped to the smallest normal, so that a zero vector gives zero instead of NaN
+        const T invMag = fastRsqrt(std::max(squareMag().value, std::numeric_limits<T>::min() ) );
+        return UnitVec{NoUnit{x.value * invMag}, NoUnit{y.value * invMag}};
+    }
+
     template<typename V>
     constexpr explicit operator Vec2<V>() const {
         return {static_cast<V>(x), static_cast<V>(y)};
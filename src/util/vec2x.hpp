@@ -0,0 +1,669 @@
+
+#ifndef HPP_UTIL_VEC2X_
+#define HPP_UTIL_VEC2X_
+
+#include "dimension.hpp"
+#include "macros.hpp"
+#include "typedefs.hpp"
+#include "vec2.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <ratio>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define UTIL_HAS_VECTOR_EXTENSIONS 1
+#endif // if defined(__GNUC__) || defined(__clang__)
+
+#if defined(UTIL_HAS_VECTOR_EXTENSIONS) && defined(__SSE2__)
+    #define UTIL_VEC2X_SSE2 1
+    #include <emmintrin.h>
+#endif // if defined(UTIL_HAS_VECTOR_EXTENSIONS) && defined(__SSE2__)
+
+
+namespace Util
+{
+
+
+// Only arithmetic types fit in the vector extensions, fixed-point types use the array
+template<typename T>
+inline constexpr bool hasVectorLanes =
+#ifdef UTIL_HAS_VECTOR_EXTENSIONS
+    std::is_arithmetic_v<T>;
+#else
+    false;
+#endif // ifdef UTIL_HAS_VECTOR_EXTENSIONS
+
+template<typename T, size_t N>
+struct ArrayLanes {
+    struct alignas(N * sizeof(T) ) Type {
+        std::array<T, N> array;
+        UTIL_ALWAYS_INLINE T& operator[](size_t i) { return array[i]; }
+        UTIL_ALWAYS_INLINE const T& operator[](size_t i) const { return array[i]; }
+    };
+};
+
+#ifdef UTIL_HAS_VECTOR_EXTENSIONS
+template<typename T, size_t N>
+struct VectorLanes {
+    typedef T Type __attribute__( (vector_size(N * sizeof(T) ) ) );
+};
+#else
+template<typename T, size_t N>
+using VectorLanes = ArrayLanes<T, N>;
+#endif // ifdef UTIL_HAS_VECTOR_EXTENSIONS
+
+/**
+ * @brief N values of an arithmetic type, kept in a SIMD register when the compiler has vector extensions
+ * @note Otherwise it's an aligned array, and the operations are loops that the compiler can vectorise
+ */
+template<typename T, size_t N>
+struct Lanes {
+    static_assert(std::is_arithmetic_v<T> || isFixed<T>, "Lanes only hold arithmetic and fixed-point types");
+    static_assert(std::has_single_bit(N), "The lane count must be a power of two");
+
+    using Native = typename std::conditional_t<hasVectorLanes<T>, VectorLanes<T, N>, ArrayLanes<T, N> >::Type;
+
+    inline static constexpr size_t laneCount = N;
+
+    Native native;
+
+    [[nodiscard]] UTIL_ALWAYS_INLINE static Lanes broadcast(T value) {
+        Lanes lanes{};
+        for(size_t i=0; i<N; ++i)
+            lanes.native[i] = value;
+        return lanes;
+    }
+
+    [[nodiscard]] UTIL_ALWAYS_INLINE static Lanes load(const T* ptr) {
+        Lanes lanes;
+        std::memcpy(&lanes.native, ptr, sizeof(Native) );
+        return lanes;
+    }
+
+    UTIL_ALWAYS_INLINE void store(T* ptr) const {
+        std::memcpy(ptr, &native, sizeof(Native) );
+    }
+
+    [[nodiscard]] UTIL_ALWAYS_INLINE T operator[](size_t i) const {
+        return native[i];
+    }
+
+    UTIL_ALWAYS_INLINE void set(size_t i, T value) {
+        native[i] = value;
+    }
+
+    /**
+     * @brief Apply the operation to the whole registers, or to each lane without vector extensions
+     */
+    template<typename F>
+    [[nodiscard]] UTIL_ALWAYS_INLINE static Lanes apply(const Lanes& lhs, const Lanes& rhs, F op) {
+        if constexpr(hasVectorLanes<T>) {
+            return {op(lhs.native, rhs.native)};
+        } else {
+            Lanes lanes;
+            for(size_t i=0; i<N; ++i)
+                lanes.native[i] = op(lhs.native[i], rhs.native[i]);
+            return lanes;
+        }
+    }
+};
+
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<T, N>
+operator+(const Lanes<T, N>& lhs, const Lanes<T, N>& rhs) {
+    return Lanes<T, N>::apply(lhs, rhs, std::plus<>{});
+}
+
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<T, N>
+operator-(const Lanes<T, N>& lhs, const Lanes<T, N>& rhs) {
+    return Lanes<T, N>::apply(lhs, rhs, std::minus<>{});
+}
+
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<T, N>
+operator*(const Lanes<T, N>& lhs, const Lanes<T, N>& rhs) {
+    return Lanes<T, N>::apply(lhs, rhs, std::multiplies<>{});
+}
+
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<T, N>
+operator/(const Lanes<T, N>& lhs, const Lanes<T, N>& rhs) {
+    return Lanes<T, N>::apply(lhs, rhs, std::divides<>{});
+}
+
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<T, N>
+operator-(const Lanes<T, N>& lanes) {
+    if constexpr(hasVectorLanes<T>) {
+        return {-lanes.native};
+    } else {
+        Lanes<T, N> out;
+        for(size_t i=0; i<N; ++i)
+            out.set(i, -lanes[i]);
+        return out;
+    }
+}
+
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<T, N>
+sqrt(const Lanes<T, N>& lanes) {
+#ifdef UTIL_VEC2X_SSE2
+    // std::sqrt can set errno, so the compiler won't vectorise it
+    if constexpr(std::is_same_v<T, float> && N == 4)
+        return {std::bit_cast<typename Lanes<T, N>::Native>(_mm_sqrt_ps(std::bit_cast<__m128>(lanes.native) ) )};
+    if constexpr(std::is_same_v<T, double> && N == 2)
+        return {std::bit_cast<typename Lanes<T, N>::Native>(_mm_sqrt_pd(std::bit_cast<__m128d>(lanes.native) ) )};
+#endif // ifdef UTIL_VEC2X_SSE2
+    using std::sqrt;
+    Lanes<T, N> out;
+    for(size_t i=0; i<N; ++i)
+        out.set(i, sqrt(lanes[i]) );
+    return out;
+}
+
+/**
+ * @brief Convert each lane to TOut, like static_cast
+ */
+template<typename TOut, typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<TOut, N>
+convert(const Lanes<T, N>& lanes) {
+    if constexpr(std::is_same_v<T, TOut>) {
+        return lanes;
+    } else if constexpr(hasVectorLanes<T> && hasVectorLanes<TOut>) {
+#ifdef UTIL_HAS_VECTOR_EXTENSIONS
+        return {__builtin_convertvector(lanes.native, typename Lanes<TOut, N>::Native)};
+#endif // ifdef UTIL_HAS_VECTOR_EXTENSIONS
+    } else {
+        Lanes<TOut, N> out;
+        for(size_t i=0; i<N; ++i)
+            out.set(i, static_cast<TOut>(lanes[i]) );
+        return out;
+    }
+}
+
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<T, N>
+max(const Lanes<T, N>& lhs, const Lanes<T, N>& rhs) {
+#ifdef UTIL_VEC2X_SSE2
+    if constexpr(std::is_same_v<T, float> && N == 4)
+        return {std::bit_cast<typename Lanes<T, N>::Native>(
+            _mm_max_ps(std::bit_cast<__m128>(lhs.native), std::bit_cast<__m128>(rhs.native) ) )};
+    if constexpr(std::is_same_v<T, double> && N == 2)
+        return {std::bit_cast<typename Lanes<T, N>::Native>(
+            _mm_max_pd(std::bit_cast<__m128d>(lhs.native), std::bit_cast<__m128d>(rhs.native) ) )};
+#endif // ifdef UTIL_VEC2X_SSE2
+    Lanes<T, N> out;
+    for(size_t i=0; i<N; ++i)
+        out.set(i, std::max(lhs[i], rhs[i]) );
+    return out;
+}
+
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<T, N>
+min(const Lanes<T, N>& lhs, const Lanes<T, N>& rhs) {
+#ifdef UTIL_VEC2X_SSE2
+    if constexpr(std::is_same_v<T, float> && N == 4)
+        return {std::bit_cast<typename Lanes<T, N>::Native>(
+            _mm_min_ps(std::bit_cast<__m128>(lhs.native), std::bit_cast<__m128>(rhs.native) ) )};
+    if constexpr(std::is_same_v<T, double> && N == 2)
+        return {std::bit_cast<typename Lanes<T, N>::Native>(
+            _mm_min_pd(std::bit_cast<__m128d>(lhs.native), std::bit_cast<__m128d>(rhs.native) ) )};
+#endif // ifdef UTIL_VEC2X_SSE2
+    Lanes<T, N> out;
+    for(size_t i=0; i<N; ++i)
+        out.set(i, std::min(lhs[i], rhs[i]) );
+    return out;
+}
+
+/**
+ * @brief Compare every lane, bit i of the result is set when lane i of lhs is less than lane i of rhs
+ * @note A bitmask rather than a register of masks, so that the results can be combined and counted as integers
+ */
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE uint32_t
+lessMask(const Lanes<T, N>& lhs, const Lanes<T, N>& rhs) {
+    static_assert(N <= 32, "The lanes must fit in the bitmask");
+#ifdef UTIL_VEC2X_SSE2
+    if constexpr(std::is_same_v<T, float> && N == 4)
+        return static_cast<uint32_t>(
+            _mm_movemask_ps(_mm_cmplt_ps(std::bit_cast<__m128>(lhs.native), std::bit_cast<__m128>(rhs.native) ) ) );
+    if constexpr(std::is_same_v<T, double> && N == 2)
+        return static_cast<uint32_t>(
+            _mm_movemask_pd(_mm_cmplt_pd(std::bit_cast<__m128d>(lhs.native), std::bit_cast<__m128d>(rhs.native) ) ) );
+#endif // ifdef UTIL_VEC2X_SSE2
+    uint32_t mask = 0;
+    for(size_t i=0; i<N; ++i)
+        mask |= static_cast<uint32_t>(lhs[i] < rhs[i]) << i;
+    return mask;
+}
+
+/**
+ * @brief The lanes of value, with zero where lane i of lhs is less than lane i of rhs
+ * @note Blends with the comparison directly, so it doesn't branch on each lane like lessMask would
+ */
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<T, N>
+zeroWhereLess(const Lanes<T, N>& value, const Lanes<T, N>& lhs, const Lanes<T, N>& rhs) {
+    if constexpr(hasVectorLanes<T>) {
+        // The comparison is all ones for true in an integer register of the same size
+        using Bits = decltype(lhs.native < rhs.native);
+        const Bits keepBits = ~(lhs.native < rhs.native);
+        return {std::bit_cast<typename Lanes<T, N>::Native>(std::bit_cast<Bits>(value.native) & keepBits)};
+    } else {
+        Lanes<T, N> out;
+        for(size_t i=0; i<N; ++i)
+            out.set(i, lhs[i] < rhs[i] ? T{} : value[i]);
+        return out;
+    }
+}
+
+/**
+ * @brief fastRsqrt for each lane, with the same error bound
+ */
+template<typename T, size_t N>
+[[nodiscard]] UTIL_ALWAYS_INLINE Lanes<T, N>
+fastRsqrt(const Lanes<T, N>& lanes) {
+#ifdef UTIL_VEC2X_SSE2
+    if constexpr(std::is_same_v<T, float> && N == 4) {
+        const Lanes<T, N> estimate{
+            std::bit_cast<typename Lanes<T, N>::Native>(_mm_rsqrt_ps(std::bit_cast<__m128>(lanes.native) ) )};
+        return estimate * (Lanes<T, N>::broadcast(1.5f) - Lanes<T, N>::broadcast(0.5f) * lanes * estimate * estimate);
+    }
+#endif // ifdef UTIL_VEC2X_SSE2
+    if constexpr(std::is_same_v<T, float>) {
+        Lanes<T, N> out;
+        for(size_t i=0; i<N; ++i)
+            out.set(i, fastRsqrt(lanes[i]) );
+        return out;
+    } else {
+        return Lanes<T, N>::broadcast(T{1}) / sqrt(lanes);
+    }
+}
+
+
+template<typename T>
+inline constexpr bool isDim = false;
+template<typename T, int L, int M, int S, typename R>
+inline constexpr bool isDim<Dim<T, L, M, S, R> > = true;
+
+template<size_t N, typename U>
+struct DimX;
+
+template<typename T>
+inline constexpr bool isDimX = false;
+template<size_t N, typename U>
+inline constexpr bool isDimX<DimX<N, U> > = true;
+
+
+/**
+ * @brief The number of lanes of T that fit in the narrowest common SIMD register (SSE and NEON)
+ */
+template<typename T>
+inline constexpr size_t defaultLaneCount = 16 / sizeof(T);
+
+
+/**
+ * @brief N lanes of a Dim quantity, with the same unit checking as a single Dim
+ * @tparam U - the Dim of each lane
+ */
+template<size_t N, typename U>
+struct DimX {
+    using Underlying = U;
+    using T = typename U::Underlying;
+    static_assert(sizeof(U) == sizeof(T), "A Dim must only hold its value");
+    inline static constexpr size_t laneCount = N;
+
+    Lanes<T, N> lanes;
+
+    [[nodiscard]] UTIL_ALWAYS_INLINE static DimX broadcast(U value) {
+        return {Lanes<T, N>::broadcast(value.value)};
+    }
+
+    /**
+     * @brief Load N consecutive values
+     */
+    [[nodiscard]] UTIL_ALWAYS_INLINE static DimX load(const U* ptr) {
+        DimX dimX;
+        std::memcpy(&dimX.lanes.native, ptr, sizeof(dimX.lanes.native) );
+        return dimX;
+    }
+
+    UTIL_ALWAYS_INLINE void store(U* ptr) const {
+        std::memcpy(ptr, &lanes.native, sizeof(lanes.native) );
+    }
+
+    [[nodiscard]] UTIL_ALWAYS_INLINE U operator[](size_t i) const {
+        return U{lanes[i]};
+    }
+
+    UTIL_ALWAYS_INLINE void set(size_t i, U value) {
+        lanes.set(i, value.value);
+    }
+
+    /**
+     * @brief Convert to another underlying type of the same unit, e.g. from double to float
+     */
+    template<typename UOut>
+    UTIL_ALWAYS_INLINE explicit operator DimX<N, UOut>() const {
+        static_assert(UOut::lengthDimension == U::lengthDimension && UOut::massDimension == U::massDimension &&
+                      UOut::timeDimension == U::timeDimension && std::ratio_equal_v<typename UOut::Ratio, typename U::Ratio>,
+                      "Only the underlying type can be converted, the unit must stay the same");
+        return {convert<typename UOut::Underlying>(lanes)};
+    }
+};
+
+
+// The result units come from the operators of a single Dim, so the same mistakes fail to compile
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE DimX<N, U>
+operator-(const DimX<N, U>& dimX) {
+    return {-dimX.lanes};
+}
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE DimX<N, U>
+operator+(const DimX<N, U>& lhs, const DimX<N, U>& rhs) {
+    return {lhs.lanes + rhs.lanes};
+}
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE DimX<N, U>
+operator-(const DimX<N, U>& lhs, const DimX<N, U>& rhs) {
+    return {lhs.lanes - rhs.lanes};
+}
+
+template<size_t N, typename U>
+UTIL_ALWAYS_INLINE DimX<N, U>&
+operator+=(DimX<N, U>& lhs, const DimX<N, U>& rhs) {
+    return lhs = lhs + rhs;
+}
+
+template<size_t N, typename U>
+UTIL_ALWAYS_INLINE DimX<N, U>&
+operator-=(DimX<N, U>& lhs, const DimX<N, U>& rhs) {
+    return lhs = lhs - rhs;
+}
+
+template<size_t N, typename U1, typename U2>
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+operator*(const DimX<N, U1>& lhs, const DimX<N, U2>& rhs) {
+    using Uout = decltype(std::declval<U1>() * std::declval<U2>() );
+    return DimX<N, Uout>{lhs.lanes * rhs.lanes};
+}
+
+template<size_t N, typename U1, typename U2>
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+operator/(const DimX<N, U1>& lhs, const DimX<N, U2>& rhs) {
+    using Uout = decltype(std::declval<U1>() / std::declval<U2>() );
+    return DimX<N, Uout>{lhs.lanes / rhs.lanes};
+}
+
+// With a single value for every lane, a Dim or its underlying type
+
+template<size_t N, typename U, typename S,
+         typename E_ = std::enable_if_t<isDim<S> || std::is_arithmetic_v<S> || isFixed<S> > >
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+operator*(const DimX<N, U>& lhs, const S& rhs) {
+    using Uout = decltype(std::declval<U>() * std::declval<S>() );
+    using T = typename U::Underlying;
+    const T rhsValue = [&rhs]{
+        if constexpr(std::is_arithmetic_v<S> || isFixed<S>)
+            return static_cast<T>(rhs);
+        else
+            return rhs.value;
+    }();
+    return DimX<N, Uout>{lhs.lanes * Lanes<T, N>::broadcast(rhsValue)};
+}
+
+template<size_t N, typename U, typename S,
+         typename E_ = std::enable_if_t<isDim<S> || std::is_arithmetic_v<S> || isFixed<S> > >
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+operator*(const S& lhs, const DimX<N, U>& rhs) {
+    return rhs * lhs;
+}
+
+template<size_t N, typename U, typename S,
+         typename E_ = std::enable_if_t<isDim<S> || std::is_arithmetic_v<S> || isFixed<S> > >
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+operator/(const DimX<N, U>& lhs, const S& rhs) {
+    using Uout = decltype(std::declval<U>() / std::declval<S>() );
+    using T = typename U::Underlying;
+    const T rhsValue = [&rhs]{
+        if constexpr(std::is_arithmetic_v<S> || isFixed<S>)
+            return static_cast<T>(rhs);
+        else
+            return rhs.value;
+    }();
+    return DimX<N, Uout>{lhs.lanes / Lanes<T, N>::broadcast(rhsValue)};
+}
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE DimX<N, U>
+min(const DimX<N, U>& lhs, const DimX<N, U>& rhs) {
+    return {min(lhs.lanes, rhs.lanes)};
+}
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE DimX<N, U>
+max(const DimX<N, U>& lhs, const DimX<N, U>& rhs) {
+    return {max(lhs.lanes, rhs.lanes)};
+}
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE uint32_t
+lessMask(const DimX<N, U>& lhs, const DimX<N, U>& rhs) {
+    return lessMask(lhs.lanes, rhs.lanes);
+}
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE DimX<N, U>
+zeroWhereLess(const DimX<N, U>& value, const DimX<N, U>& lhs, const DimX<N, U>& rhs) {
+    return {zeroWhereLess(value.lanes, lhs.lanes, rhs.lanes)};
+}
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+sqrt(const DimX<N, U>& dimX) {
+    using Uout = decltype(sqrt(std::declval<U>() ) );
+    return DimX<N, Uout>{sqrt(dimX.lanes)};
+}
+
+
+/**
+ * @brief N two dimensional vectors, stored as a register of x and a register of y
+ * @tparam U - the Dim of each component
+ * @example Vec2x<4, BaseLength> positions = Vec2x<4, BaseLength>::load(positionLst.data() );
+ */
+template<size_t N, typename U>
+struct Vec2x {
+    using Underlying = U;
+    inline static constexpr size_t laneCount = N;
+
+    DimX<N, U> x;
+    DimX<N, U> y;
+
+    [[nodiscard]] UTIL_ALWAYS_INLINE static Vec2x broadcast(const Vec2<U>& vec) {
+        return {DimX<N, U>::broadcast(vec.x), DimX<N, U>::broadcast(vec.y)};
+    }
+
+    /**
+     * @brief Load N consecutive vectors, and split them into the x and y registers
+     */
+    [[nodiscard]] UTIL_ALWAYS_INLINE static Vec2x load(const Vec2<U>* ptr) {
+        Vec2x vecX;
+        for(size_t i=0; i<N; ++i) {
+            vecX.x.set(i, ptr[i].x);
+            vecX.y.set(i, ptr[i].y);
+        }
+        return vecX;
+    }
+
+    /**
+     * @brief Load N consecutive x and N consecutive y values, from a structure-of-arrays
+     */
+    [[nodiscard]] UTIL_ALWAYS_INLINE static Vec2x load(const U* xPtr, const U* yPtr) {
+        return {DimX<N, U>::load(xPtr), DimX<N, U>::load(yPtr)};
+    }
+
+    UTIL_ALWAYS_INLINE void store(Vec2<U>* ptr) const {
+        for(size_t i=0; i<N; ++i)
+            ptr[i] = {x[i], y[i]};
+    }
+
+    UTIL_ALWAYS_INLINE void store(U* xPtr, U* yPtr) const {
+        x.store(xPtr);
+        y.store(yPtr);
+    }
+
+    [[nodiscard]] UTIL_ALWAYS_INLINE Vec2<U> operator[](size_t i) const {
+        return {x[i], y[i]};
+    }
+
+    [[nodiscard]] UTIL_ALWAYS_INLINE auto squareMag() const {
+        return x*x + y*y;
+    }
+
+    [[nodiscard]] UTIL_ALWAYS_INLINE auto magnitude() const {
+        return sqrt(x*x + y*y);
+    }
+
+    template<typename UOut>
+    UTIL_ALWAYS_INLINE explicit operator Vec2x<N, UOut>() const {
+        return {static_cast<DimX<N, UOut> >(x), static_cast<DimX<N, UOut> >(y)};
+    }
+
+    /**
+     * @brief Vec2::unitFast for each lane, zero vectors give zero
+     */
+    [[nodiscard]] UTIL_ALWAYS_INLINE auto unitFast() const {
+        using NoUnit = typename decltype(std::declval<Vec2<U> >().unitFast() )::Underlying;
+        using T = typename U::Underlying;
+        using LanesT = Lanes<T, N>;
+        const LanesT invMag = fastRsqrt(max(squareMag().lanes, LanesT::broadcast(std::numeric_limits<T>::min() ) ) );
+        return Vec2x<N, NoUnit>{DimX<N, NoUnit>{x.lanes * invMag}, DimX<N, NoUnit>{y.lanes * invMag}};
+    }
+};
+
+
+template<size_t N, typename U1, typename U2>
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+dot(const Vec2x<N, U1>& lhs, const Vec2x<N, U2>& rhs) {
+    return lhs.x * rhs.x + lhs.y * rhs.y;
+}
+
+template<size_t N, typename U1, typename U2>
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+elemMul(const Vec2x<N, U1>& lhs, const Vec2x<N, U2>& rhs) {
+    using Uout = decltype(std::declval<U1>() * std::declval<U2>() );
+    return Vec2x<N, Uout>{lhs.x * rhs.x, lhs.y * rhs.y};
+}
+
+template<size_t N, typename U1, typename U2>
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+elemDiv(const Vec2x<N, U1>& lhs, const Vec2x<N, U2>& rhs) {
+    using Uout = decltype(std::declval<U1>() / std::declval<U2>() );
+    return Vec2x<N, Uout>{lhs.x / rhs.x, lhs.y / rhs.y};
+}
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE Vec2x<N, U>
+operator-(const Vec2x<N, U>& vec) {
+    return {-vec.x, -vec.y};
+}
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE Vec2x<N, U>
+operator+(const Vec2x<N, U>& lhs, const Vec2x<N, U>& rhs) {
+    return {lhs.x + rhs.x, lhs.y + rhs.y};
+}
+
+template<size_t N, typename U>
+[[nodiscard]] UTIL_ALWAYS_INLINE Vec2x<N, U>
+operator-(const Vec2x<N, U>& lhs, const Vec2x<N, U>& rhs) {
+    return {lhs.x - rhs.x, lhs.y - rhs.y};
+}
+
+template<size_t N, typename U>
+UTIL_ALWAYS_INLINE Vec2x<N, U>&
+operator+=(Vec2x<N, U>& lhs, const Vec2x<N, U>& rhs) {
+    return lhs = lhs + rhs;
+}
+
+template<size_t N, typename U>
+UTIL_ALWAYS_INLINE Vec2x<N, U>&
+operator-=(Vec2x<N, U>& lhs, const Vec2x<N, U>& rhs) {
+    return lhs = lhs - rhs;
+}
+
+// Scaled by a value for each lane (a DimX), or the same value for every lane (a Dim or its underlying type)
+
+template<size_t N, typename U, typename S,
+         typename E_ = std::enable_if_t<isDimX<S> || isDim<S> || std::is_arithmetic_v<S> || isFixed<S> > >
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+operator*(const Vec2x<N, U>& lhs, const S& rhs) {
+    using Uout = typename decltype(lhs.x * rhs)::Underlying;
+    return Vec2x<N, Uout>{lhs.x * rhs, lhs.y * rhs};
+}
+
+template<size_t N, typename U, typename S,
+         typename E_ = std::enable_if_t<isDimX<S> || isDim<S> || std::is_arithmetic_v<S> || isFixed<S> > >
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+operator*(const S& lhs, const Vec2x<N, U>& rhs) {
+    return rhs * lhs;
+}
+
+template<size_t N, typename U, typename S,
+         typename E_ = std::enable_if_t<isDimX<S> || isDim<S> || std::is_arithmetic_v<S> || isFixed<S> > >
+[[nodiscard]] UTIL_ALWAYS_INLINE auto
+operator/(const Vec2x<N, U>& lhs, const S& rhs) {
+    using Uout = typename decltype(lhs.x / rhs)::Underlying;
+    return Vec2x<N, Uout>{lhs.x / rhs, lhs.y / rhs};
+}
+
+
+/**
+ * @brief Normalize every vector in vecLst with Vec2::unitFast, into unitLst
+ * @note unitLst must be at least as long as vecLst, and may be the same memory when the types match
+ */
+template<typename U, typename NoUnit>
+void unitFast(std::span<const Vec2<U> > vecLst, std::span<Vec2<NoUnit> > unitLst) {
+    static_assert(std::is_same_v<NoUnit, typename decltype(std::declval<Vec2<U> >().unitFast() )::Underlying>,
+                  "unitLst must hold the unit vector type of vecLst");
+    constexpr size_t laneCount = defaultLaneCount<typename U::Underlying>;
+    assert(unitLst.size() >= vecLst.size() );
+
+    size_t i = 0;
+    for(; i + laneCount <= vecLst.size(); i += laneCount)
+        Vec2x<laneCount, U>::load(vecLst.data() + i).unitFast().store(unitLst.data() + i);
+    for(; i<vecLst.size(); ++i)
+        unitLst[i] = vecLst[i].unitFast();
+}
+
+
+// Typedefs with the default lane count
+
+template<typename U>
+using DefaultDimX = DimX<defaultLaneCount<typename U::Underlying>, U>;
+template<typename U>
+using DefaultVec2x = Vec2x<defaultLaneCount<typename U::Underlying>, U>;
+
+using BasePositionX = DefaultVec2x<BasePositionScalar>;
+using BaseDisplacementX = DefaultVec2x<BaseDistance>;
+using BaseVelocityX = DefaultVec2x<BaseSpeed>;
+
+
+}  // namespace Util
+
+#endif  // HPP_UTIL_VEC2X_
@@ -0,0 +1,110 @@
+
+#include "worker_pool.hpp"
+
+#include "profiler.hpp"
+
+#include <algorithm>
+
+
+namespace Util
+{
+
+
+WorkerPool::WorkerPool(size_t threadCount_) {
+    mThreadLst.reserve(threadCount_);
+    for(size_t i=0; i<threadCount_; ++i)
+        mThreadLst.emplace_back([this]{workerLoop();});
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard lock{mMutex};
+        mIsStopping = true;
+    }
+    mWorkReady.notify_all();
+    for(auto& thread : mThreadLst)
+        thread.join();
+}
+
+size_t WorkerPool::threadCount() const {
+    return mThreadLst.size();
+}
+
+void WorkerPool::run(size_t taskCount, TaskFunction taskFunction, const void* taskCtx) {
+    if(mThreadLst.empty() || taskCount <= 1) {
+        for(size_t i=0; i<taskCount; ++i)
+            taskFunction(taskCtx, i);
+        return;
+    }
+
+    {
+        std::unique_lock lock{mMutex};
+        // A worker that woke up late for the previous parallelFor must leave before the task counter is reset
+        mWorkDone.wait(lock, [this]{return mActiveWorkerCount == 0;});
+        ++mGeneration;
+        mTaskCount = taskCount;
+        mTaskFunction = taskFunction;
+        mTaskCtx = taskCtx;
+        mNextTask.store(0, std::memory_order_relaxed);
+    }
+    mWorkReady.notify_all();
+
+    runTasks(taskCount, taskFunction, taskCtx);
+
+    // Every task has been claimed, so wait for the workers that are still running theirs
+    std::unique_lock lock{mMutex};
+    mWorkDone.wait(lock, [this]{return mActiveWorkerCount == 0;});
+}
+
+void WorkerPool::runTasks(size_t taskCount, TaskFunction taskFunction, const void* taskCtx) {
+    for(size_t i = mNextTask.fetch_add(1); i < taskCount; i = mNextTask.fetch_add(1) )
+        taskFunction(taskCtx, i);
+}
+
+void WorkerPool::workerLoop() {
+#ifdef UTIL_ENABLE_PROFILER
+    // Naming the thread creates its ring buffer, which is only needed when zones are recorded
+    Profiler::setThreadName("worker");
+#endif // ifdef UTIL_ENABLE_PROFILER
+    uint64_t seenGeneration = 0;
+    while(true) {
+        /*[[uninit]]*/ size_t taskCount;
+        /*[[uninit]]*/ TaskFunction taskFunction;
+        /*[[uninit]]*/ const void* taskCtx;
+        {
+            std::unique_lock lock{mMutex};
+            mWorkReady.wait(lock, [&]{return mIsStopping || mGeneration != seenGeneration;});
+            if(mIsStopping)
+                return;
+            seenGeneration = mGeneration;
+            taskCount = mTaskCount;
+            taskFunction = mTaskFunction;
+            taskCtx = mTaskCtx;
+            ++mActiveWorkerCount;
+        }
+
+        runTasks(taskCount, taskFunction, taskCtx);
+
+        {
+            std::lock_guard lock{mMutex};
+            --mActiveWorkerCount;
+        }
+        mWorkDone.notify_all();
+    }
+}
+
+WorkerPool& defaultWorkerPool() {
+#ifdef __EMSCRIPTEN__
+    // Threads are not available without SharedArrayBuffer, so everything is run on the main thread
+    constexpr size_t spareThreadCount = 0;
+#else
+    // hardware_concurrency can return zero if it's unknown
+    const size_t hardwareThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    const size_t spareThreadCount = hardwareThreadCount - 1;
+#endif // ifdef __EMSCRIPTEN__
+    static WorkerPool sWorkerPool{spareThreadCount};
+    return sWorkerPool;
+}
+
+
+} // namespace Util
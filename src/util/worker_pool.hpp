@@ -0,0 +1,76 @@
+
+#ifndef HPP_UTIL_WORKERPOOL_
+#define HPP_UTIL_WORKERPOOL_
+
+#include "typedefs.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace Util
+{
+
+
+/**
+ * @brief A fixed set of worker threads for splitting a loop into tasks
+ * @note parallelFor doesn't allocate, so it can be used every frame
+ */
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t threadCount_);
+    ~WorkerPool();
+    WorkerPool& operator=(WorkerPool&&) = delete; // no copy nor move
+
+    [[nodiscard]] size_t threadCount() const;
+
+    /**
+     * @brief Run task(i) for every i in [0, taskCount), and wait for all of them to be done
+     * @note The calling thread also runs tasks, and the tasks may be run in any order
+     * @note Not re-entrant, so a task cannot call parallelFor
+     */
+    template<typename F>
+    void parallelFor(size_t taskCount, const F& task) {
+        constexpr TaskFunction taskFunction = [](const void* ctx, size_t i) {
+            (*static_cast<const F*>(ctx) )(i);
+        };
+        run(taskCount, taskFunction, std::addressof(task) );
+    }
+
+private:
+    using TaskFunction = void(*)(const void*, size_t);
+
+    void run(size_t taskCount, TaskFunction taskFunction, const void* taskCtx);
+    void runTasks(size_t taskCount, TaskFunction taskFunction, const void* taskCtx);
+    void workerLoop();
+
+    std::mutex mMutex{};
+    std::condition_variable mWorkReady{};
+    std::condition_variable mWorkDone{};
+    // The current parallelFor, guarded by mMutex
+    uint64_t mGeneration{};
+    size_t mTaskCount{};
+    TaskFunction mTaskFunction{};
+    const void* mTaskCtx{};
+    size_t mActiveWorkerCount{};
+    bool mIsStopping{};
+    std::atomic<size_t> mNextTask{};
+
+    std::vector<std::thread> mThreadLst{};
+};
+
+
+/**
+ * @brief The worker pool shared by the game, with a thread for each spare hardware thread
+ */
+[[nodiscard]] WorkerPool& defaultWorkerPool();
+
+
+} // namespace Util
+
+#endif // ifndef HPP_UTIL_WORKERPOOL_